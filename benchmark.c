@@ -0,0 +1,311 @@
+/*
+ * File: benchmark.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#include <stdio.h>
+
+#include "pico/stdlib.h"
+#include "dwm_pico_5110_LCD/dwm_pico_5110_LCD.h"
+#include "dwm_pico_5110_LCD/dwm_pico_5110_LCD_rowmajor.h"
+#include "dwm_pico_5110_LCD/dwm_pico_5110_LCD_parallel.h"
+
+#define SPI_PORT spi1
+#define SCE_PIN 13
+#define RST_PIN 12
+#define DC_PIN 11
+#define DIN_PIN 15
+#define SCLK_PIN 14
+
+#define REPEAT 20
+
+// 32x16 row-major test image (checkerboard of 4x4 squares)
+static uint8_t image[4 * 16];
+
+// Complex frame for the parallel rendering benchmark
+static struct LCD_batch batch;
+
+// Random points for the point plotting benchmark
+#define MAX_POINTS 4000
+static uint16_t points[MAX_POINTS];
+
+void printResult(const char *name, uint32_t vertical, uint32_t rowMajor)
+{
+    printf("%-24s %10lu %10lu\n", name, (unsigned long)vertical / REPEAT, (unsigned long)rowMajor / REPEAT);
+}
+
+void benchmarkLayouts()
+{
+    uint32_t start, vertical, rowMajor;
+
+    for (uint8_t y = 0; y < 16; y++)
+        for (uint8_t i = 0; i < 4; i++)
+            image[y * 4 + i] = (y / 4) % 2 ? 0x0F : 0xF0;
+
+    printf("\nFramebuffer layouts (us per run)\n");
+    printf("%-24s %10s %10s\n", "workload", "vertical", "row-major");
+
+    // Both layouts use the same kind of primitive, so results show the cost of the layout
+    // Horizontal spans, pixel by pixel
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        for (uint8_t y = 0; y < LCD_HEIGHT; y++)
+            for (uint8_t x = 0; x < LCD_WIDTH; x++)
+                LCD_setPixel(x, y, true);
+    vertical = time_us_32() - start;
+
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        for (uint8_t y = 0; y < LCD_HEIGHT; y++)
+            for (uint8_t x = 0; x < LCD_WIDTH; x++)
+                LCD_rowSetPixel(x, y, true);
+    rowMajor = time_us_32() - start;
+
+    printResult("horizontal pixels", vertical, rowMajor);
+
+    // Horizontal spans, one line per screen line
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        for (uint8_t y = 0; y < LCD_HEIGHT; y++)
+            LCD_drawLine(0, y, LCD_WIDTH - 1, y);
+    vertical = time_us_32() - start;
+
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        for (uint8_t y = 0; y < LCD_HEIGHT; y++)
+            LCD_rowFillRectangle(0, y, LCD_WIDTH - 1, y, true);
+    rowMajor = time_us_32() - start;
+
+    printResult("horizontal lines", vertical, rowMajor);
+
+    // Vertical spans, pixel by pixel
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        for (uint8_t x = 0; x < LCD_WIDTH; x++)
+            for (uint8_t y = 0; y < LCD_HEIGHT; y++)
+                LCD_setPixel(x, y, true);
+    vertical = time_us_32() - start;
+
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        for (uint8_t x = 0; x < LCD_WIDTH; x++)
+            for (uint8_t y = 0; y < LCD_HEIGHT; y++)
+                LCD_rowSetPixel(x, y, true);
+    rowMajor = time_us_32() - start;
+
+    printResult("vertical pixels", vertical, rowMajor);
+
+    // Vertical spans, one line per column
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        for (uint8_t x = 0; x < LCD_WIDTH; x++)
+            LCD_drawLine(x, 0, x, LCD_HEIGHT - 1);
+    vertical = time_us_32() - start;
+
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        for (uint8_t x = 0; x < LCD_WIDTH; x++)
+            LCD_rowFillRectangle(x, 0, x, LCD_HEIGHT - 1, true);
+    rowMajor = time_us_32() - start;
+
+    printResult("vertical lines", vertical, rowMajor);
+
+    // Row-major image import at unaligned position, pixel by pixel
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        for (uint8_t y = 0; y < 16; y++)
+            for (uint8_t x = 0; x < 32; x++)
+                if (image[y * 4 + x / 8] >> (7 - x % 8) & 1)
+                    LCD_setPixel(x + 3, y + 3, true);
+    vertical = time_us_32() - start;
+
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        for (uint8_t y = 0; y < 16; y++)
+            for (uint8_t x = 0; x < 32; x++)
+                if (image[y * 4 + x / 8] >> (7 - x % 8) & 1)
+                    LCD_rowSetPixel(x + 3, y + 3, true);
+    rowMajor = time_us_32() - start;
+
+    printResult("image pixels", vertical, rowMajor);
+
+    // Image import with the layout's native blit, row-major has no conversion to do
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        LCD_rowDrawImage(image, 32, 16, 3, 3);
+    rowMajor = time_us_32() - start;
+
+    printResult("image blit", 0, rowMajor);
+
+    // Sending the frame, row-major includes transposition
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        LCD_refreshScr();
+    vertical = time_us_32() - start;
+
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        LCD_rowRefreshScr();
+    rowMajor = time_us_32() - start;
+
+    printResult("refresh", vertical, rowMajor);
+
+    // Transposition alone
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        LCD_rowToBuffer(LCD_getStreamBuffer());
+    rowMajor = time_us_32() - start;
+
+    printResult("transpose only", 0, rowMajor);
+}
+
+void benchmarkParallel()
+{
+    uint32_t start, single, core0 = 0, core1 = 0, parallel = 0;
+    const struct LCD_parallelTimes *times;
+
+    LCD_batchReset(&batch);
+    LCD_batchClrBuff(&batch);
+    for (uint8_t i = 0; i < 40; i++)
+        LCD_batchLine(&batch, (i * 7) % LCD_WIDTH, (i * 13) % LCD_HEIGHT, (i * 29) % LCD_WIDTH, (i * 5 + 20) % LCD_HEIGHT);
+    for (uint8_t i = 0; i < 8; i++)
+        LCD_batchCircle(&batch, 10 + i * 9, 12 + (i % 4) * 8, 4 + i);
+    LCD_batchTriangle(&batch, 0, 47, 40, 0, 83, 30);
+    LCD_batchRectangle(&batch, 5, 5, 78, 42);
+    LCD_batchPrint(&batch, "12:34", 12, 1, 2);
+    LCD_batchPrint(&batch, "parallel", 0, 5, 1);
+
+    printf("\nParallel rendering (us per frame)\n");
+
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+        LCD_batchReplay(&batch);
+    single = time_us_32() - start;
+
+    for (uint8_t n = 0; n < REPEAT; n++)
+    {
+        times = LCD_parallelRender(&batch);
+        core0 += times->coreUs[0];
+        core1 += times->coreUs[1];
+        parallel += times->totalUs;
+    }
+
+    printf("%-24s %10lu\n", "single core", (unsigned long)single / REPEAT);
+    printf("%-24s %10lu\n", "core 0 band", (unsigned long)core0 / REPEAT);
+    printf("%-24s %10lu\n", "core 1 band", (unsigned long)core1 / REPEAT);
+    printf("%-24s %10lu\n", "both cores", (unsigned long)parallel / REPEAT);
+}
+
+void benchmarkPoints()
+{
+    const uint16_t counts[] = {100, 1000, MAX_POINTS};
+    uint32_t start, single, batched, seed = 1;
+
+    for (uint16_t i = 0; i < MAX_POINTS; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        points[i] = LCD_PACK_POINT((seed >> 16) % LCD_WIDTH, (seed >> 8) % LCD_HEIGHT);
+    }
+
+    printf("\nPoint plotting (us per run)\n");
+    printf("%-24s %10s %10s\n", "points", "setPixel", "setPixels");
+
+    for (uint8_t i = 0; i < sizeof(counts) / sizeof(counts[0]); i++)
+    {
+        char name[24];
+
+        LCD_clrBuff();
+        start = time_us_32();
+        for (uint8_t n = 0; n < REPEAT; n++)
+            for (uint16_t j = 0; j < counts[i]; j++)
+                LCD_setPixel(points[j] & 0xFF, points[j] >> 8, true);
+        single = time_us_32() - start;
+
+        LCD_clrBuff();
+        start = time_us_32();
+        for (uint8_t n = 0; n < REPEAT; n++)
+            LCD_setPixels(points, counts[i], true);
+        batched = time_us_32() - start;
+
+        snprintf(name, sizeof(name), "%u", counts[i]);
+        printResult(name, single, batched);
+    }
+
+    // Sending changed spans only
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+    {
+        LCD_togglePixels(points, counts[0]);
+        LCD_refreshDirty();
+    }
+    batched = time_us_32() - start;
+
+    printResult("toggle + refresh 100", 0, batched);
+}
+
+void benchmarkInit()
+{
+    const struct LCD_config config = LCD_CONFIG_DEFAULT;
+    uint32_t start, sequential, single = 0;
+
+    printf("\nBoot to first frame (us per run)\n");
+
+    // Command by command init, blank screen, then the first frame
+    start = time_us_32();
+    for (uint8_t n = 0; n < REPEAT; n++)
+    {
+        LCD_writeCommand(0x21);
+        LCD_writeCommand(0xB8);
+        LCD_writeCommand(0x04);
+        LCD_writeCommand(0x14);
+        LCD_writeCommand(0x20);
+        LCD_writeCommand(LCD_DISPLAY_NORMAL);
+        LCD_clrScr();
+        LCD_refreshScr();
+    }
+    sequential = time_us_32() - start;
+
+    for (uint8_t n = 0; n < REPEAT; n++)
+        single += LCD_initConfig(&config);
+
+    printf("%-24s %10lu\n", "sequential", (unsigned long)sequential / REPEAT);
+    printf("%-24s %10lu\n", "single transaction", (unsigned long)single / REPEAT);
+}
+
+int main()
+{
+    stdio_init_all();
+
+    // Set gpio pins.
+    LCD_setSPIInstance(SPI_PORT);
+    LCD_setSCE(SCE_PIN);
+    LCD_setRST(RST_PIN);
+    LCD_setDC(DC_PIN);
+    LCD_setDIN(DIN_PIN);
+    LCD_setSCLK(SCLK_PIN);
+
+    // Init SPI communication protocol with max allowed speed.
+    spi_init(SPI_PORT, LCD_SPI_MAX_SPEED);
+
+    // Init LCD
+    LCD_init();
+
+    // Core 1 renders the lower band in benchmarkParallel()
+    LCD_parallelInit();
+
+    while (true)
+    {
+        benchmarkLayouts();
+        benchmarkParallel();
+        benchmarkPoints();
+        benchmarkInit();
+
+        sleep_ms(5000);
+    }
+}
@@ -10,6 +10,7 @@
  */
 
 #include <stdio.h>
+#include <string.h>
 
 #include "pico/stdlib.h"
 #include "hardware/spi.h"
@@ -20,9 +21,110 @@
 #define STATE_HIGH 1
 #define STATE_LOW 0
 
-struct LCD_att lcd;
+// Time of a transfer on top of sending its bytes (CS and D/C toggles, calls), first LCD_refreshStep() estimate
+#define STEP_SETUP_US 20
+
+// Bit reversal lookup, used to flip bank bytes upside down while streaming.
+#define R2(n) n, n + 2 * 64, n + 1 * 64, n + 3 * 64
+#define R4(n) R2(n), R2(n + 2 * 16), R2(n + 1 * 16), R2(n + 3 * 16)
+#define R6(n) R4(n), R4(n + 2 * 4), R4(n + 1 * 4), R4(n + 3 * 4)
+
+const uint8_t lcd_bitReverse[256] = {R6(0), R6(2), R6(1), R6(3)};
+
+#undef R2
+#undef R4
+#undef R6
+
+// Bit spreading lookup, every bit of a nibble repeated 2, 3 or 4 times (scaled text).
+static const uint16_t bitSpread[LCD_TEXT_MAX_SCALE - 1][16] = {
+    {0x0000, 0x0003, 0x000C, 0x000F, 0x0030, 0x0033, 0x003C, 0x003F, 0x00C0, 0x00C3, 0x00CC, 0x00CF, 0x00F0, 0x00F3, 0x00FC, 0x00FF},
+    {0x0000, 0x0007, 0x0038, 0x003F, 0x01C0, 0x01C7, 0x01F8, 0x01FF, 0x0E00, 0x0E07, 0x0E38, 0x0E3F, 0x0FC0, 0x0FC7, 0x0FF8, 0x0FFF},
+    {0x0000, 0x000F, 0x00F0, 0x00FF, 0x0F00, 0x0F0F, 0x0FF0, 0x0FFF, 0xF000, 0xF00F, 0xF0F0, 0xF0FF, 0xFF00, 0xFF0F, 0xFFF0, 0xFFFF},
+};
+
+struct LCD_att lcd = {.target = lcd.buffer};
 struct LCD_GPIO lcd_gpio;
 
+// Staging area for frames that need reordering before they are sent.
+static uint8_t stream[LCD_SIZE];
+
+#if LCD_ENABLE_STATS
+static struct LCD_stats stats;
+#else
+// Counters stay at 0, constant keeps them out of RAM
+static const struct LCD_stats stats;
+#endif
+
+// Lines each core draws in (LCD_setBand()), indexed by core number
+static uint8_t bandTop[2];
+static uint8_t bandBottom[2] = {LCD_HEIGHT, LCD_HEIGHT};
+
+// LCD_refreshStep() state: rows as they were queued, rows not sent yet and worst cost of one row seen
+static uint8_t stepFrame[LCD_SIZE];
+static uint8_t stepPending = (1 << LCD_ROW_NUMBER) - 1;
+static uint32_t stepRowUs;
+
+// LCD_setPixels() state: masks collected per byte, bytes with a mask, columns changed in every row (right exclusive)
+static uint8_t pixelMask[LCD_SIZE];
+static uint16_t pixelTouched[LCD_SIZE];
+static uint8_t dirtyLeft[LCD_ROW_NUMBER] = {LCD_WIDTH, LCD_WIDTH, LCD_WIDTH, LCD_WIDTH, LCD_WIDTH, LCD_WIDTH};
+static uint8_t dirtyRight[LCD_ROW_NUMBER];
+
+// Orientation helpers, defined with the refresh functions
+static void LCD_stageArea(const uint8_t *frame, uint8_t x0, uint8_t x1, uint8_t row, uint8_t nRow, bool flipX, bool flipY);
+static bool LCD_flipX();
+static bool LCD_flipY();
+
+#if LCD_ENABLE_SHADOW
+static struct LCD_shadow shadow = {.display = LCD_DISPLAY_BLANK};
+
+#define SHADOW_COMMAND(command) LCD_shadowCommand(command)
+#define SHADOW_DATA(data, size) LCD_shadowData((data), (size))
+#else
+static const struct LCD_shadow shadow = {.display = LCD_DISPLAY_BLANK};
+
+#define SHADOW_COMMAND(command)
+#define SHADOW_DATA(data, size)
+#endif
+
+#if LCD_ENABLE_STATS
+static enum LCD_statsApi statsApi = LCD_API_OTHER;
+// Primitive being drawn, per core as both cores draw at the same time (LCD_parallelRender())
+static enum LCD_statsPrimitive statsPrimitive[2] = {LCD_PRIMITIVE_PIXEL, LCD_PRIMITIVE_PIXEL};
+// Pixels drawn per core, summed into stats.pixels by LCD_getStats()
+static uint32_t statsPixels[2][LCD_PRIMITIVE_COUNT];
+
+// Counters are attributed to the outermost library call
+#define STATS_API_BEGIN(api)                  \
+  enum LCD_statsApi statsApiOuter = statsApi; \
+  if (statsApiOuter == LCD_API_OTHER)         \
+  statsApi = (api)
+#define STATS_API_END() (statsApi = statsApiOuter)
+#define STATS_PRIMITIVE_BEGIN(core, primitive)                             \
+  uint8_t statsCore = (core);                                              \
+  enum LCD_statsPrimitive statsPrimitiveOuter = statsPrimitive[statsCore]; \
+  if (statsPrimitiveOuter == LCD_PRIMITIVE_PIXEL)                          \
+  statsPrimitive[statsCore] = (primitive)
+#define STATS_PRIMITIVE_END() (statsPrimitive[statsCore] = statsPrimitiveOuter)
+#define STATS_PIXEL(core) (statsPixels[core][statsPrimitive[core]]++)
+#define STATS_PIXELS(core, count) (statsPixels[core][statsPrimitive[core]] += (count))
+#define STATS_GOXY() (stats.goXY++)
+#define STATS_TIMER_START() uint32_t statsStart = time_us_32()
+#define STATS_TRANSFER(size, commands) LCD_statsTransfer((size), (commands), time_us_32() - statsStart)
+#define STATS_REFRESH() LCD_statsRefresh(time_us_32() - statsStart)
+#else
+#define STATS_API_BEGIN(api)
+#define STATS_API_END()
+#define STATS_PRIMITIVE_BEGIN(core, primitive)
+#define STATS_PRIMITIVE_END()
+#define STATS_PIXEL(core)
+#define STATS_PIXELS(core, count)
+#define STATS_GOXY()
+#define STATS_TIMER_START()
+#define STATS_TRANSFER(size, commands)
+#define STATS_REFRESH()
+#endif
+
 /*-------- SPI CONF --------*/
 
 /**
@@ -87,6 +189,201 @@ void LCD_setSCLK(uint16_t PIN)
   lcd_gpio.SCLK = PIN;
 }
 
+/*----- Statistics -----*/
+
+#if LCD_ENABLE_STATS
+/**
+ * @brief Account one SPI transaction.
+ *
+ * @param size      number of bytes sent.
+ * @param commands  how many of them are commands, the rest is data.
+ * @param blockedUs time spent waiting for SPI.
+ */
+static void LCD_statsTransfer(uint16_t size, uint16_t commands, uint32_t blockedUs)
+{
+  struct LCD_trafficStats *traffic[] = {&stats.total, &stats.api[statsApi]};
+
+  for (uint8_t i = 0; i < 2; i++)
+  {
+    traffic[i]->bytes += size;
+    traffic[i]->commands += commands;
+    traffic[i]->transactions++;
+    traffic[i]->blockedUs += blockedUs;
+  }
+
+  stats.csToggles += 2;
+}
+
+/**
+ * @brief Account one screen refresh.
+ *
+ * @param us refresh duration.
+ */
+static void LCD_statsRefresh(uint32_t us)
+{
+  uint8_t bucket = 0;
+
+  while (bucket < LCD_STATS_HISTOGRAM_SIZE - 1 && us >= ((uint32_t)LCD_STATS_HISTOGRAM_BASE_US << bucket))
+    bucket++;
+
+  stats.refreshHistogram[bucket]++;
+  stats.refreshes++;
+  stats.refreshTotalUs += us;
+  if (us > stats.refreshMaxUs)
+    stats.refreshMaxUs = us;
+}
+#endif
+
+/**
+ * @brief Get performance counters.
+ *
+ * @attention Counters are only collected when library is built with LCD_ENABLE_STATS set to 1,
+ *            otherwise they stay at 0.
+ *
+ * @return pointer to counters, updated in place. Pixel counts are kept per core
+ *         and summed on every call.
+ */
+const struct LCD_stats *LCD_getStats()
+{
+#if LCD_ENABLE_STATS
+  for (uint8_t i = 0; i < LCD_PRIMITIVE_COUNT; i++)
+    stats.pixels[i] = statsPixels[0][i] + statsPixels[1][i];
+#endif
+
+  return &stats;
+}
+
+/**
+ * @brief Reset performance counters.
+ */
+void LCD_resetStats()
+{
+#if LCD_ENABLE_STATS
+  memset(&stats, 0, sizeof(stats));
+  memset(statsPixels, 0, sizeof(statsPixels));
+#endif
+}
+
+/**
+ * @brief Print performance counters on stdio.
+ */
+void LCD_printStats()
+{
+  static const char *apiNames[LCD_API_COUNT] = {"init", "text", "clear", "refresh", "control", "other"};
+  static const char *primitiveNames[LCD_PRIMITIVE_COUNT] = {"pixel", "line", "rectangle", "triangle", "circle", "fill"};
+
+  if (!LCD_ENABLE_STATS)
+  {
+    printf("LCD stats disabled (LCD_ENABLE_STATS=0)\n");
+    return;
+  }
+
+  LCD_getStats();
+
+  printf("LCD stats\n");
+  printf("%-10s %10s %10s %10s %10s\n", "api", "bytes", "commands", "trans", "blocked_us");
+  for (uint8_t i = 0; i <= LCD_API_COUNT; i++)
+  {
+    const struct LCD_trafficStats *traffic = i < LCD_API_COUNT ? &stats.api[i] : &stats.total;
+
+    printf("%-10s %10lu %10lu %10lu %10lu\n", i < LCD_API_COUNT ? apiNames[i] : "total",
+           (unsigned long)traffic->bytes, (unsigned long)traffic->commands,
+           (unsigned long)traffic->transactions, (unsigned long)traffic->blockedUs);
+  }
+
+  printf("cs_toggles %lu goxy %lu\n", (unsigned long)stats.csToggles, (unsigned long)stats.goXY);
+
+  for (uint8_t i = 0; i < LCD_PRIMITIVE_COUNT; i++)
+    printf("pixels_%s %lu\n", primitiveNames[i], (unsigned long)stats.pixels[i]);
+
+  printf("refreshes %lu total_us %lu max_us %lu\n", (unsigned long)stats.refreshes,
+         (unsigned long)stats.refreshTotalUs, (unsigned long)stats.refreshMaxUs);
+
+  for (uint8_t i = 0; i < LCD_STATS_HISTOGRAM_SIZE; i++)
+    if (i < LCD_STATS_HISTOGRAM_SIZE - 1)
+      printf("refresh_lt_%luus %lu\n", (unsigned long)LCD_STATS_HISTOGRAM_BASE_US << i, (unsigned long)stats.refreshHistogram[i]);
+    else
+      printf("refresh_ge_%luus %lu\n", (unsigned long)LCD_STATS_HISTOGRAM_BASE_US << (i - 1), (unsigned long)stats.refreshHistogram[i]);
+}
+
+/*----- Shadow -----*/
+
+#if LCD_ENABLE_SHADOW
+/**
+ * @brief Decode a command the way PCD8544 does.
+ *
+ * @param command command sent to the LCD.
+ */
+static void LCD_shadowCommand(uint8_t command)
+{
+  // Function set is valid in both instruction sets
+  if ((command & 0xF8) == LCD_FUNCTION_SET)
+  {
+    shadow.extended = command & 0x01;
+    shadow.vertical = command & LCD_VERTICAL_ADDRESSING;
+    return;
+  }
+
+  // Extended instructions (Vop, bias, temperature) don't change the picture
+  if (shadow.extended)
+    return;
+
+  if (command & LCD_SETXADDR)
+  {
+    if ((command & 0x7F) < LCD_WIDTH)
+      shadow.x = command & 0x7F;
+  }
+  else if (command & LCD_SETYADDR)
+  {
+    if ((command & 0x07) < LCD_ROW_NUMBER)
+      shadow.y = command & 0x07;
+  }
+  else if ((command & 0xFA) == LCD_DISPLAY_BLANK)
+    shadow.display = command;
+}
+
+/**
+ * @brief Store data in the shadow RAM and advance the address counter.
+ *
+ * @param data data sent to the LCD.
+ * @param size size of the data.
+ */
+static void LCD_shadowData(const uint8_t *data, uint16_t size)
+{
+  for (uint16_t i = 0; i < size; i++)
+  {
+    shadow.ram[shadow.y * LCD_WIDTH + shadow.x] = data[i];
+
+    if (shadow.vertical)
+    {
+      if (++shadow.y == LCD_ROW_NUMBER)
+      {
+        shadow.y = 0;
+        shadow.x = shadow.x + 1 == LCD_WIDTH ? 0 : shadow.x + 1;
+      }
+    }
+    else if (++shadow.x == LCD_WIDTH)
+    {
+      shadow.x = 0;
+      shadow.y = shadow.y + 1 == LCD_ROW_NUMBER ? 0 : shadow.y + 1;
+    }
+  }
+}
+#endif
+
+/**
+ * @brief Get the shadow copy of the panel.
+ *
+ * @attention Shadow is only kept when library is built with LCD_ENABLE_SHADOW set to 1,
+ *            otherwise it stays blank.
+ *
+ * @return pointer to the shadow, updated in place.
+ */
+const struct LCD_shadow *LCD_getShadow()
+{
+  return &shadow;
+}
+
 /*----- Library Functions -----*/
 
 /**
@@ -96,10 +393,15 @@ void LCD_setSCLK(uint16_t PIN)
  */
 void LCD_writeCommand(uint8_t command)
 {
+  STATS_TIMER_START();
+
   gpio_put(lcd_gpio.DC, STATE_LOW);
   gpio_put(lcd_gpio.SCE, STATE_LOW);
   spi_write_blocking(lcd.spi, &command, 1);
   gpio_put(lcd_gpio.SCE, STATE_HIGH);
+
+  SHADOW_COMMAND(command);
+  STATS_TRANSFER(1, 1);
 }
 
 /**
@@ -108,12 +410,17 @@ void LCD_writeCommand(uint8_t command)
  * @param data data to be written.
  * @param size size of the data.
  */
-void LCD_writeData(uint8_t *data, uint16_t size)
+void LCD_writeData(const uint8_t *data, uint16_t size)
 {
+  STATS_TIMER_START();
+
   gpio_put(lcd_gpio.DC, STATE_HIGH);
   gpio_put(lcd_gpio.SCE, STATE_LOW);
   spi_write_blocking(lcd.spi, data, size);
   gpio_put(lcd_gpio.SCE, STATE_HIGH);
+
+  SHADOW_DATA(data, size);
+  STATS_TRANSFER(size, 0);
 }
 
 /**
@@ -123,9 +430,45 @@ void LCD_writeData(uint8_t *data, uint16_t size)
  */
 void LCD_init()
 {
+  const struct LCD_config config = LCD_CONFIG_DEFAULT;
+
+  LCD_initConfig(&config);
+}
+
+/**
+ * @brief Initialize the LCD with given configuration and show the first frame.
+ *        Configuration commands, the frame and display on command are sent in a single
+ *        transaction, the display is turned on only when its RAM holds the frame.
+ *        Splash frame is copied to lcd.buffer, without a splash lcd.buffer is left as it is
+ *        (same as LCD_init() always did) and a blank frame is sent.
+ *
+ * @attention Must initialise SPI first! Max supported speed is 4MHZ (LCD_SPI_MAX_SPEED)
+ *
+ * @param config  contrast, bias, temperature coefficient and splash frame.
+ *
+ * @return time from releasing reset to the frame being shown, in us.
+ */
+uint32_t LCD_initConfig(const struct LCD_config *config)
+{
+  STATS_API_BEGIN(LCD_API_INIT);
+  STATS_TIMER_START();
+
+  const uint8_t commands[] = {
+      LCD_FUNCTION_SET | LCD_EXTENDED_INSTRUCTIONS,
+      LCD_SET_VOP | (config->contrast & 0x7F),
+      LCD_SET_TEMPERATURE | (config->temperature & 0x03),
+      LCD_SET_BIAS | (config->bias & 0x07),
+      LCD_FUNCTION_SET,
+      LCD_SETXADDR,
+      LCD_SETYADDR,
+  };
+  const uint8_t displayOn = LCD_DISPLAY_NORMAL;
+  const uint8_t *frame = stream;
+
   // Setup SCE (slave chip enable), RST and D/C (data / command select) pins as output
   gpio_init(lcd_gpio.SCE);
   gpio_set_dir(lcd_gpio.SCE, GPIO_OUT);
+  gpio_put(lcd_gpio.SCE, STATE_HIGH);
 
   gpio_init(lcd_gpio.RST);
   gpio_set_dir(lcd_gpio.RST, GPIO_OUT);
@@ -137,21 +480,49 @@ void LCD_init()
   gpio_set_function(lcd_gpio.DIN, GPIO_FUNC_SPI);
   gpio_set_function(lcd_gpio.SCLK, GPIO_FUNC_SPI);
 
+  // Frame is prepared before reset, so nothing delays the transfer
+  if (!config->splash)
+    memset(stream, 0, LCD_SIZE);
+  else
+  {
+    memcpy(lcd.buffer, config->splash, LCD_SIZE);
+
+    if (LCD_flipX() || LCD_flipY())
+      LCD_stageArea(lcd.buffer, 0, LCD_WIDTH, 0, LCD_ROW_NUMBER, LCD_flipX(), LCD_flipY());
+    else
+      frame = lcd.buffer;
+  }
+
   // Reset screen registers
   gpio_put(lcd_gpio.RST, STATE_LOW);
   sleep_us(1);
   gpio_put(lcd_gpio.RST, STATE_HIGH);
 
-  // Perform initial commands
-  LCD_writeCommand(0x21);               // LCD extended commands.
-  LCD_writeCommand(0xB8);               // set LCD Vop(Contrast).
-  LCD_writeCommand(0x04);               // set temp coefficent.
-  LCD_writeCommand(0x14);               // LCD bias mode 1:40.
-  LCD_writeCommand(0x20);               // LCD basic commands.
-  LCD_writeCommand(LCD_DISPLAY_NORMAL); // LCD normal.
-  LCD_clrScr();
+  uint32_t start = time_us_32();
+
+  // D/C is sampled with the last bit of every byte, so it's switched between blocking writes
+  gpio_put(lcd_gpio.DC, STATE_LOW);
+  gpio_put(lcd_gpio.SCE, STATE_LOW);
+  spi_write_blocking(lcd.spi, commands, sizeof(commands));
+  gpio_put(lcd_gpio.DC, STATE_HIGH);
+  spi_write_blocking(lcd.spi, frame, LCD_SIZE);
+  gpio_put(lcd_gpio.DC, STATE_LOW);
+  spi_write_blocking(lcd.spi, &displayOn, 1);
+  gpio_put(lcd_gpio.SCE, STATE_HIGH);
+
+  uint32_t elapsed = time_us_32() - start;
+
+  for (uint8_t i = 0; i < sizeof(commands); i++)
+    SHADOW_COMMAND(commands[i]);
+  SHADOW_DATA(frame, LCD_SIZE);
+  SHADOW_COMMAND(displayOn);
+  STATS_TRANSFER(sizeof(commands) + LCD_SIZE + 1, sizeof(commands) + 1);
 
   lcd.invertText = false;
+
+  STATS_API_END();
+
+  return elapsed;
 }
 
 /**
@@ -161,10 +532,14 @@ void LCD_init()
  */
 void LCD_invert(bool mode)
 {
+  STATS_API_BEGIN(LCD_API_CONTROL);
+
   if (mode)
     LCD_writeCommand(LCD_DISPLAY_INVERTED);
   else
     LCD_writeCommand(LCD_DISPLAY_NORMAL);
+
+  STATS_API_END();
 }
 
 /**
@@ -177,6 +552,74 @@ void LCD_invertText(bool mode)
   lcd.invertText = mode;
 }
 
+/**
+ * @brief Smooth diagonals of scaled text.
+ *
+ * @param mode: true = smoothed / false = blocky.
+ */
+void LCD_smoothText(bool mode)
+{
+  lcd.smoothText = mode;
+}
+
+/**
+ * @brief Set orientation of the picture on the panel.
+ *        Rotation is applied when the buffer is sent to the LCD,
+ *        drawing functions are not affected.
+ *
+ * @attention LCD_ROTATE_90 and LCD_ROTATE_270 swap the geometry, use LCD_refreshPortrait()
+ *            for these. LCD_refreshScr() and LCD_refreshArea() treat them as LCD_ROTATE_0.
+ *
+ * @param rotation clockwise rotation.
+ */
+void LCD_setRotation(enum LCD_rotation rotation)
+{
+  lcd.rotation = rotation;
+}
+
+/**
+ * @brief Restrict drawing functions called from the current core to a band of rows.
+ *        Cores drawing in separate bands never touch the same byte of lcd.buffer.
+ *
+ * @param row   starting row (multiple of 8 lines).
+ * @param nRow  number of rows, LCD_setBand(0, LCD_ROW_NUMBER) draws on the whole screen again.
+ */
+void LCD_setBand(uint8_t row, uint8_t nRow)
+{
+  uint8_t core = get_core_num();
+
+  if (row > LCD_ROW_NUMBER)
+    row = LCD_ROW_NUMBER;
+  if (row + nRow > LCD_ROW_NUMBER)
+    nRow = LCD_ROW_NUMBER - row;
+
+  bandTop[core] = row * LCD_COLUMN_HEIGHT;
+  bandBottom[core] = (row + nRow) * LCD_COLUMN_HEIGHT;
+}
+
+/**
+ * @brief Redirect draw functions to another frame.
+ *
+ * @param frame frame in lcd.buffer layout (LCD_SIZE bytes), NULL = lcd.buffer.
+ */
+void LCD_setDrawTarget(uint8_t *frame)
+{
+  lcd.target = frame ? frame : lcd.buffer;
+}
+
+/**
+ * @brief Mirror the picture on the panel.
+ *        Applied on top of rotation, when the buffer is sent to the LCD.
+ *
+ * @param horizontal  true = columns are reversed (left <-> right).
+ * @param vertical    true = lines are reversed (top <-> bottom).
+ */
+void LCD_setMirror(bool horizontal, bool vertical)
+{
+  lcd.mirrorX = horizontal;
+  lcd.mirrorY = vertical;
+}
+
 /**
  * @brief abs function used in LCD_drawLine.
  *
@@ -197,6 +640,8 @@ int abs(int x)
  */
 void LCD_putChar(char c)
 {
+  STATS_API_BEGIN(LCD_API_TEXT);
+
   uint8_t letter[FONT_SYMBOL_WIDTH];
 
   for (int i = 0; i < FONT_SYMBOL_WIDTH; i++)
@@ -206,6 +651,8 @@ void LCD_putChar(char c)
       letter[i] = ASCII[c - 0x20][i];
 
   LCD_writeData(letter, FONT_SYMBOL_WIDTH);
+
+  STATS_API_END();
 }
 
 /**
@@ -217,9 +664,13 @@ void LCD_putChar(char c)
  */
 void LCD_print(char *str, uint8_t x0, uint8_t row)
 {
+  STATS_API_BEGIN(LCD_API_TEXT);
+
   LCD_goXY(x0, row);
   while (*str)
     LCD_putChar(*str++);
+
+  STATS_API_END();
 }
 
 /**
@@ -238,87 +689,587 @@ void LCD_printCenter(char *str, uint8_t length, uint8_t row)
 }
 
 /**
- * @brief Updates a square of the screen according to given values.
+ * @brief Fill corners between diagonal neighbours of a scaled glyph.
  *
- * @param x0      starting point on x-axis.
- * @param x1      ending point on x-axis.
- * @param row     starting row (multiple of 8 lines).
- * @param nRow    numer of rows to refresh.
+ * @param glyph   source glyph columns.
+ * @param out     scaled columns, one bit per line.
+ * @param scale   scale factor.
  */
-void LCD_refreshArea(uint8_t x0, uint8_t x1, uint8_t row, uint8_t nRow)
+static void LCD_smoothGlyph(const uint8_t *glyph, uint32_t *out, uint8_t scale)
 {
-  for (uint8_t i = 0; i < nRow; i++)
-  {
-    LCD_goXY(x0, row + i);
+  for (uint8_t i = 0; i + 1 < FONT_SYMBOL_WIDTH; i++)
+    for (uint8_t j = 0; j + 1 < LCD_COLUMN_HEIGHT; j++)
+    {
+      bool topLeft = glyph[i] >> j & 1;
+      bool bottomLeft = glyph[i] >> (j + 1) & 1;
+      bool topRight = glyph[i + 1] >> j & 1;
+      bool bottomRight = glyph[i + 1] >> (j + 1) & 1;
 
-    for (uint8_t j = x0; j < x1; j++)
-      LCD_writeData(&lcd.buffer[(row + i) * LCD_WIDTH + j], 1);
-  }
+      for (uint8_t u = 0; u < scale; u++)
+        for (uint8_t v = 0; v < scale; v++)
+        {
+          // "\" diagonal fills upper right and lower left block, "/" the other two
+          if (topLeft && bottomRight && !topRight && !bottomLeft)
+          {
+            if (u < v)
+              out[(i + 1) * scale + u] |= 1UL << (j * scale + v);
+            if (u > v)
+              out[i * scale + u] |= 1UL << ((j + 1) * scale + v);
+          }
+          if (topRight && bottomLeft && !topLeft && !bottomRight)
+          {
+            if (u + v > scale - 1)
+              out[i * scale + u] |= 1UL << (j * scale + v);
+            if (u + v < scale - 1)
+              out[(i + 1) * scale + u] |= 1UL << ((j + 1) * scale + v);
+          }
+        }
+    }
 }
 
 /**
- * @brief     Clears the screen.
- * @attention Does not clear the buffer!
+ * @brief Draws one scaled char in lcd.buffer.
+ *        Glyph columns are spread with lookup tables, each one gives scale bytes.
+ *
+ * @param c       char to be drawn.
+ * @param x0      starting point on the x-axis.
+ * @param row     row number (multiple of 8 lines).
+ * @param scale   scale factor, 1 - LCD_TEXT_MAX_SCALE.
  */
-void LCD_clrScr()
+void LCD_putCharScaled(char c, uint8_t x0, uint8_t row, uint8_t scale)
 {
-  static uint8_t zero = 0x00;
+  const uint8_t *glyph = ASCII[c - 0x20];
+  uint32_t out[FONT_SYMBOL_WIDTH * LCD_TEXT_MAX_SCALE];
+  uint32_t mask;
+  uint8_t core = get_core_num();
 
-  for (int i = 0; i < LCD_SIZE; i++)
-    LCD_writeData(&zero, 1);
-}
+  if (scale < 1)
+    scale = 1;
+  if (scale > LCD_TEXT_MAX_SCALE)
+    scale = LCD_TEXT_MAX_SCALE;
 
-/**
- * @brief Clears lcd.buffer.
- */
-void LCD_clrBuff()
-{
-  for (int i = 0; i < LCD_SIZE; i++)
-    lcd.buffer[i] = 0;
+  mask = scale == LCD_TEXT_MAX_SCALE ? UINT32_MAX : (1UL << (scale * LCD_COLUMN_HEIGHT)) - 1;
+
+  for (uint8_t i = 0; i < FONT_SYMBOL_WIDTH; i++)
+  {
+    uint32_t column = glyph[i];
+
+    if (scale > 1)
+      column = bitSpread[scale - 2][glyph[i] & 0x0F] | (uint32_t)bitSpread[scale - 2][glyph[i] >> 4] << (scale * 4);
+
+    for (uint8_t j = 0; j < scale; j++)
+      out[i * scale + j] = column;
+  }
+
+  if (lcd.smoothText && scale > 1)
+    LCD_smoothGlyph(glyph, out, scale);
+
+  for (uint8_t i = 0; i < FONT_SYMBOL_WIDTH * scale && x0 + i < LCD_WIDTH; i++)
+  {
+    uint32_t column = lcd.invertText ? ~out[i] & mask : out[i];
+
+    for (uint8_t j = 0; j < scale && row + j < LCD_ROW_NUMBER; j++)
+      if ((row + j) * LCD_COLUMN_HEIGHT >= bandTop[core] && (row + j) * LCD_COLUMN_HEIGHT < bandBottom[core])
+      {
+        lcd.target[(row + j) * LCD_WIDTH + x0 + i] = column >> (j * LCD_COLUMN_HEIGHT);
+        lcd.targetDirty |= 1 << (row + j);
+      }
+  }
 }
 
 /**
- * @brief Set LCD's cursor to position X,Y.
+ * @brief Draws a scaled string in lcd.buffer.
+ *        It's necessary to use LCD_refreshScr() or LCD_refreshArea() in order to send it to the LCD.
  *
- * @param x       position on the x-axis.
+ * @param str     string to draw.
+ * @param x0      starting point on the x-axis.
  * @param row     row number (multiple of 8 lines).
+ * @param scale   scale factor, 1 - LCD_TEXT_MAX_SCALE.
  */
-void LCD_goXY(uint8_t x0, uint8_t row)
+void LCD_printScaled(char *str, uint8_t x0, uint8_t row, uint8_t scale)
 {
-  LCD_writeCommand(LCD_SETXADDR | x0);  // Column.
-  LCD_writeCommand(LCD_SETYADDR | row); // Rows.
+  while (*str && x0 < LCD_WIDTH)
+  {
+    LCD_putCharScaled(*str++, x0, row, scale);
+    x0 += FONT_SYMBOL_WIDTH * scale;
+  }
 }
 
 /**
- * @brief Updates the entire screen according to lcd.buffer.
+ * @brief Copy part of a frame to stream, in the order it's shown on the panel.
+ *
+ * @param frame   frame in lcd.buffer layout.
+ * @param x0      starting point on x-axis.
+ * @param x1      ending point on x-axis (exclusive).
+ * @param row     starting row (multiple of 8 lines).
+ * @param nRow    number of rows.
+ * @param flipX   true = reverse columns.
+ * @param flipY   true = reverse lines.
  */
-void LCD_refreshScr()
+static void LCD_stageArea(const uint8_t *frame, uint8_t x0, uint8_t x1, uint8_t row, uint8_t nRow, bool flipX, bool flipY)
 {
-  LCD_goXY(LCD_SETXADDR, LCD_SETYADDR);
-  LCD_writeData(lcd.buffer, LCD_SIZE);
+  uint8_t width = x1 - x0;
+
+  // Whole frame already in stream (LCD_getStreamBuffer()), mirroring pairs bytes up, so swap them in place
+  if (frame == stream)
+  {
+    for (uint16_t i = 0; i < LCD_SIZE; i++)
+    {
+      uint16_t j = (flipY ? LCD_ROW_NUMBER - 1 - i / LCD_WIDTH : i / LCD_WIDTH) * LCD_WIDTH +
+                   (flipX ? LCD_WIDTH - 1 - i % LCD_WIDTH : i % LCD_WIDTH);
+      uint8_t byte = stream[i];
+
+      if (j < i)
+        continue;
+
+      stream[i] = flipY ? lcd_bitReverse[stream[j]] : stream[j];
+      stream[j] = flipY ? lcd_bitReverse[byte] : byte;
+    }
+    return;
+  }
+
+  for (uint8_t i = 0; i < nRow; i++)
+  {
+    const uint8_t *src = &frame[(flipY ? row + nRow - 1 - i : row + i) * LCD_WIDTH];
+    uint8_t *dst = &stream[i * width];
+
+    for (uint8_t j = 0; j < width; j++)
+    {
+      uint8_t byte = flipX ? src[x1 - 1 - j] : src[x0 + j];
+      dst[j] = flipY ? lcd_bitReverse[byte] : byte;
+    }
+  }
 }
 
 /**
- * @brief Sets a pixel on the screen.
+ * @brief Send part of a frame in buffer layout to the LCD, applying orientation.
+ *        Mirrored columns are streamed in reverse order, mirrored lines use bit reversed bytes.
  *
- * @param x0    pixel location on x axis.
- * @param y0    pixel location on y axis.
- * @param mode  true = lit pixel / false = dim pixel.
+ * @param frame   frame in lcd.buffer layout.
+ * @param x0      starting point on x-axis.
+ * @param x1      ending point on x-axis (exclusive).
+ * @param row     starting row (multiple of 8 lines).
+ * @param nRow    number of rows to send.
+ * @param flipX   true = reverse columns.
+ * @param flipY   true = reverse lines.
  */
-void LCD_setPixel(uint8_t x0, uint8_t y0, bool mode)
+static void LCD_streamArea(const uint8_t *frame, uint8_t x0, uint8_t x1, uint8_t row, uint8_t nRow, bool flipX, bool flipY)
 {
-  if (x0 >= LCD_WIDTH)
-    x0 = LCD_WIDTH - 1;
-  if (y0 >= LCD_HEIGHT)
-    y0 = LCD_HEIGHT - 1;
+  uint8_t width = x1 - x0;
+  uint8_t panelX = flipX ? LCD_WIDTH - x1 : x0;
+  uint8_t panelRow = flipY ? LCD_ROW_NUMBER - row - nRow : row;
+  const uint8_t *data = &frame[row * LCD_WIDTH + x0];
+  uint8_t stride = LCD_WIDTH;
 
-  if (mode)
-    lcd.buffer[x0 + (y0 / LCD_COLUMN_HEIGHT) * LCD_WIDTH] |= 1 << (y0 % LCD_COLUMN_HEIGHT);
-  else
-    lcd.buffer[x0 + (y0 / LCD_COLUMN_HEIGHT) * LCD_WIDTH] &= ~(1 << (y0 % LCD_COLUMN_HEIGHT));
-}
+  if (flipX || flipY)
+  {
+    data = stream;
+    stride = width;
+    LCD_stageArea(frame, x0, x1, row, nRow, flipX, flipY);
+  }
 
-/**
+  // Full width rows are continuous in LCD's memory, send them at once
+  if (width == LCD_WIDTH)
+  {
+    LCD_goXY(0, panelRow);
+    LCD_writeData(data, width * nRow);
+    return;
+  }
+
+  for (uint8_t i = 0; i < nRow; i++)
+  {
+    LCD_goXY(panelX, panelRow + i);
+    LCD_writeData(&data[i * stride], width);
+  }
+}
+
+/**
+ * @brief Check whether columns have to be reversed for current orientation.
+ */
+static bool LCD_flipX()
+{
+  return (lcd.rotation == LCD_ROTATE_180) != lcd.mirrorX;
+}
+
+/**
+ * @brief Check whether lines have to be reversed for current orientation.
+ */
+static bool LCD_flipY()
+{
+  return (lcd.rotation == LCD_ROTATE_180) != lcd.mirrorY;
+}
+
+/**
+ * @brief Updates a square of the screen according to given values.
+ *
+ * @param x0      starting point on x-axis.
+ * @param x1      ending point on x-axis.
+ * @param row     starting row (multiple of 8 lines).
+ * @param nRow    numer of rows to refresh.
+ */
+void LCD_refreshArea(uint8_t x0, uint8_t x1, uint8_t row, uint8_t nRow)
+{
+  if (x1 > LCD_WIDTH)
+    x1 = LCD_WIDTH;
+  if (row + nRow > LCD_ROW_NUMBER)
+    nRow = row < LCD_ROW_NUMBER ? LCD_ROW_NUMBER - row : 0;
+  if (x0 >= x1 || !nRow)
+    return;
+
+  STATS_API_BEGIN(LCD_API_REFRESH);
+  STATS_TIMER_START();
+
+  LCD_streamArea(lcd.buffer, x0, x1, row, nRow, LCD_flipX(), LCD_flipY());
+
+  STATS_REFRESH();
+  STATS_API_END();
+}
+
+/**
+ * @brief Updates part of a single column of the screen according to lcd.buffer.
+ *        Uses vertical addressing, so the whole column is one transfer.
+ *
+ * @param x0      column on x-axis.
+ * @param row     starting row (multiple of 8 lines).
+ * @param nRow    number of rows to refresh.
+ */
+void LCD_refreshColumn(uint8_t x0, uint8_t row, uint8_t nRow)
+{
+  uint8_t column[LCD_ROW_NUMBER];
+  bool flipY = LCD_flipY();
+
+  if (row + nRow > LCD_ROW_NUMBER)
+    nRow = row < LCD_ROW_NUMBER ? LCD_ROW_NUMBER - row : 0;
+  if (x0 >= LCD_WIDTH || !nRow)
+    return;
+
+  STATS_API_BEGIN(LCD_API_REFRESH);
+  STATS_TIMER_START();
+
+  for (uint8_t i = 0; i < nRow; i++)
+  {
+    uint8_t byte = lcd.buffer[(flipY ? row + nRow - 1 - i : row + i) * LCD_WIDTH + x0];
+    column[i] = flipY ? lcd_bitReverse[byte] : byte;
+  }
+
+  LCD_writeCommand(LCD_FUNCTION_SET | LCD_VERTICAL_ADDRESSING);
+  LCD_goXY(LCD_flipX() ? LCD_WIDTH - 1 - x0 : x0, flipY ? LCD_ROW_NUMBER - row - nRow : row);
+  LCD_writeData(column, nRow);
+  LCD_writeCommand(LCD_FUNCTION_SET);
+
+  STATS_REFRESH();
+  STATS_API_END();
+}
+
+/**
+ * @brief     Clears the screen.
+ * @attention Does not clear the buffer!
+ */
+void LCD_clrScr()
+{
+  STATS_API_BEGIN(LCD_API_CLEAR);
+
+  static uint8_t zero = 0x00;
+
+  for (int i = 0; i < LCD_SIZE; i++)
+    LCD_writeData(&zero, 1);
+
+  STATS_API_END();
+}
+
+/**
+ * @brief Clears lcd.buffer (or current draw target).
+ */
+void LCD_clrBuff()
+{
+  for (int i = 0; i < LCD_SIZE; i++)
+    lcd.target[i] = 0;
+
+  lcd.targetDirty = (1 << LCD_ROW_NUMBER) - 1;
+}
+
+/**
+ * @brief Set LCD's cursor to position X,Y.
+ *
+ * @param x       position on the x-axis.
+ * @param row     row number (multiple of 8 lines).
+ */
+void LCD_goXY(uint8_t x0, uint8_t row)
+{
+  STATS_GOXY();
+
+  LCD_writeCommand(LCD_SETXADDR | x0);  // Column.
+  LCD_writeCommand(LCD_SETYADDR | row); // Rows.
+}
+
+/**
+ * @brief Updates the entire screen according to lcd.buffer.
+ */
+void LCD_refreshScr()
+{
+  STATS_API_BEGIN(LCD_API_REFRESH);
+  STATS_TIMER_START();
+
+  LCD_streamArea(lcd.buffer, 0, LCD_WIDTH, 0, LCD_ROW_NUMBER, LCD_flipX(), LCD_flipY());
+
+  STATS_REFRESH();
+  STATS_API_END();
+}
+
+/**
+ * @brief Sends pending rows of lcd.buffer, as many as fit in the time budget.
+ *        Call it repeatedly (e.g. in idle slots of the main loop), a row changed in lcd.buffer
+ *        is queued again, even when the previous version hasn't been sent yet.
+ *        Rows are sent only if the slowest row seen so far would still fit, the first estimate
+ *        is the wire time plus a fixed setup time, so the budget holds unless an interrupt
+ *        stretches a transfer beyond anything measured before.
+ *
+ * @attention Nothing is sent if the budget is shorter than one row (about 250us at 4MHz).
+ *
+ * @param budgetUs  maximum time spent in the call.
+ *
+ * @return true if the screen shows lcd.buffer, false if some rows are still pending.
+ */
+bool LCD_refreshStep(uint32_t budgetUs)
+{
+  uint32_t start = time_us_32();
+
+  // Seed row cost from SPI speed: row data and 2 address commands, 8 bits each, plus setup
+  if (!stepRowUs)
+    stepRowUs = (uint64_t)(LCD_WIDTH + 2) * 8 * 1000000 / spi_get_baudrate(lcd.spi) + 1 + STEP_SETUP_US;
+
+  for (uint8_t row = 0; row < LCD_ROW_NUMBER; row++)
+  {
+    uint8_t *queued = &stepFrame[row * LCD_WIDTH];
+
+    if (memcmp(queued, &lcd.buffer[row * LCD_WIDTH], LCD_WIDTH))
+    {
+      memcpy(queued, &lcd.buffer[row * LCD_WIDTH], LCD_WIDTH);
+      stepPending |= 1 << row;
+    }
+  }
+
+  for (uint8_t row = 0; row < LCD_ROW_NUMBER && stepPending;)
+  {
+    uint8_t nRow = 0;
+
+    if (!(stepPending & 1 << row))
+    {
+      row++;
+      continue;
+    }
+
+    // Adjacent pending rows are sent in one transfer
+    while (row + nRow < LCD_ROW_NUMBER && stepPending & 1 << (row + nRow) &&
+           time_us_32() - start + (nRow + 1) * stepRowUs <= budgetUs)
+      nRow++;
+
+    if (!nRow)
+      break;
+
+    uint32_t sendStart = time_us_32();
+
+    STATS_API_BEGIN(LCD_API_REFRESH);
+    LCD_streamArea(stepFrame, 0, LCD_WIDTH, row, nRow, LCD_flipX(), LCD_flipY());
+    STATS_API_END();
+
+    // Worst case, transfer setup is charged to every row, so longer transfers are overestimated
+    uint32_t rowUs = (time_us_32() - sendStart + nRow - 1) / nRow;
+    if (rowUs > stepRowUs)
+      stepRowUs = rowUs;
+    stepPending &= ~(((1 << nRow) - 1) << row);
+    row += nRow;
+  }
+
+  return !stepPending;
+}
+
+/**
+ * @brief Queue the entire screen for LCD_refreshStep() and measure row cost again.
+ *        Needed after the panel was changed by other means (e.g. LCD_clrScr(), rotation change).
+ */
+void LCD_refreshStepReset()
+{
+  stepPending = (1 << LCD_ROW_NUMBER) - 1;
+  stepRowUs = 0;
+}
+
+/**
+ * @brief Sends columns changed by LCD_setPixels() / LCD_togglePixels() since last call.
+ */
+void LCD_refreshDirty()
+{
+  for (uint8_t row = 0; row < LCD_ROW_NUMBER; row++)
+  {
+    if (dirtyLeft[row] < dirtyRight[row])
+      LCD_refreshArea(dirtyLeft[row], dirtyRight[row], row, 1);
+
+    dirtyLeft[row] = LCD_WIDTH;
+    dirtyRight[row] = 0;
+  }
+}
+
+/**
+ * @brief Get the buffer frames are staged in before they are sent.
+ *        A frame can be built in it and passed to LCD_refreshFrame(), saving a second frame of RAM.
+ *
+ * @attention Contents are overwritten by every refresh.
+ *
+ * @return LCD_SIZE bytes buffer.
+ */
+uint8_t *LCD_getStreamBuffer()
+{
+  return stream;
+}
+
+/**
+ * @brief Updates the entire screen according to given frame.
+ *
+ * @param frame frame in lcd.buffer layout (LCD_SIZE bytes), may be LCD_getStreamBuffer().
+ */
+void LCD_refreshFrame(const uint8_t *frame)
+{
+  STATS_API_BEGIN(LCD_API_REFRESH);
+  STATS_TIMER_START();
+
+  LCD_streamArea(frame, 0, LCD_WIDTH, 0, LCD_ROW_NUMBER, LCD_flipX(), LCD_flipY());
+
+  STATS_REFRESH();
+  STATS_API_END();
+}
+
+/**
+ * @brief Transpose 8x8 bit block.
+ *        Bit j of i-th source byte becomes bit i of j-th destination byte.
+ *
+ * @param src         first source byte.
+ * @param srcStride   distance between source bytes.
+ * @param dst         first destination byte.
+ * @param dstStride   distance between destination bytes.
+ */
+void LCD_transpose8(const uint8_t *src, uint16_t srcStride, uint8_t *dst, uint16_t dstStride)
+{
+  uint32_t x, y, t;
+
+  // Bytes are loaded in reverse order, so MSB first kernel works for LSB first bytes
+  x = (uint32_t)src[7 * srcStride] << 24 | (uint32_t)src[6 * srcStride] << 16 | src[5 * srcStride] << 8 | src[4 * srcStride];
+  y = (uint32_t)src[3 * srcStride] << 24 | (uint32_t)src[2 * srcStride] << 16 | src[srcStride] << 8 | src[0];
+
+  t = (x ^ (x >> 7)) & 0x00AA00AA;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AA;
+  y = y ^ t ^ (t << 7);
+
+  t = (x ^ (x >> 14)) & 0x0000CCCC;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCC;
+  y = y ^ t ^ (t << 14);
+
+  t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+  y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+  x = t;
+
+  dst[7 * dstStride] = x >> 24;
+  dst[6 * dstStride] = x >> 16;
+  dst[5 * dstStride] = x >> 8;
+  dst[4 * dstStride] = x;
+  dst[3 * dstStride] = y >> 24;
+  dst[2 * dstStride] = y >> 16;
+  dst[dstStride] = y >> 8;
+  dst[0] = y;
+}
+
+/**
+ * @brief Updates the entire screen with a portrait frame, rotated by 90 or 270 degrees
+ *        according to LCD_setRotation(). Frame is converted in 8x8 blocks.
+ *
+ * @param frame frame of LCD_PORTRAIT_WIDTH x LCD_PORTRAIT_HEIGHT pixels in lcd.buffer layout
+ *              (LCD_PORTRAIT_BANKS rows of LCD_PORTRAIT_WIDTH bytes, LCD_PORTRAIT_SIZE in total).
+ * @return      time spent on block transposition, in microseconds.
+ */
+uint32_t LCD_refreshPortrait(const uint8_t *frame)
+{
+  STATS_API_BEGIN(LCD_API_REFRESH);
+  STATS_TIMER_START();
+
+  uint8_t block[LCD_COLUMN_HEIGHT];
+  uint32_t start = time_us_32();
+  bool clockwise = lcd.rotation != LCD_ROTATE_270;
+  bool flipY = clockwise == lcd.mirrorY;
+
+  for (uint8_t bank = 0; bank < LCD_PORTRAIT_BANKS; bank++)
+    for (uint8_t row = 0; row < LCD_ROW_NUMBER; row++)
+    {
+      // Portrait columns map onto LCD's lines, portrait lines onto LCD's columns
+      uint8_t *dst = &stream[(flipY ? LCD_ROW_NUMBER - 1 - row : row) * LCD_WIDTH];
+
+      LCD_transpose8(&frame[bank * LCD_PORTRAIT_WIDTH + row * LCD_COLUMN_HEIGHT], 1, block, 1);
+
+      for (uint8_t i = 0; i < LCD_COLUMN_HEIGHT; i++)
+      {
+        uint8_t y = bank * LCD_COLUMN_HEIGHT + i;
+
+        if (y >= LCD_PORTRAIT_HEIGHT)
+          break;
+
+        if (clockwise != lcd.mirrorX)
+          y = LCD_WIDTH - 1 - y;
+
+        dst[y] = flipY ? lcd_bitReverse[block[i]] : block[i];
+      }
+    }
+
+  uint32_t elapsed = time_us_32() - start;
+
+  LCD_goXY(0, 0);
+  LCD_writeData(stream, LCD_SIZE);
+
+  STATS_REFRESH();
+  STATS_API_END();
+
+  return elapsed;
+}
+
+/**
+ * @brief Sets a pixel on the screen, for primitives that know their core already.
+ *
+ * @param core  core drawing the pixel (get_core_num()).
+ * @param x0    pixel location on x axis.
+ * @param y0    pixel location on y axis.
+ * @param mode  true = lit pixel / false = dim pixel.
+ */
+static void LCD_plotPixel(uint8_t core, uint8_t x0, uint8_t y0, bool mode)
+{
+  STATS_PIXEL(core);
+
+  if (x0 >= LCD_WIDTH)
+    x0 = LCD_WIDTH - 1;
+  if (y0 >= LCD_HEIGHT)
+    y0 = LCD_HEIGHT - 1;
+  if (y0 < bandTop[core] || y0 >= bandBottom[core])
+    return;
+
+  if (mode)
+    lcd.target[x0 + (y0 / LCD_COLUMN_HEIGHT) * LCD_WIDTH] |= 1 << (y0 % LCD_COLUMN_HEIGHT);
+  else
+    lcd.target[x0 + (y0 / LCD_COLUMN_HEIGHT) * LCD_WIDTH] &= ~(1 << (y0 % LCD_COLUMN_HEIGHT));
+
+  lcd.targetDirty |= 1 << (y0 / LCD_COLUMN_HEIGHT);
+}
+
+/**
+ * @brief Sets a pixel on the screen.
+ *
+ * @param x0    pixel location on x axis.
+ * @param y0    pixel location on y axis.
+ * @param mode  true = lit pixel / false = dim pixel.
+ */
+void LCD_setPixel(uint8_t x0, uint8_t y0, bool mode)
+{
+  LCD_plotPixel(get_core_num(), x0, y0, mode);
+}
+
+/**
  * @brief Get pixel state in the buffer.
  *
  * @param x0 pixel location on x axis.
@@ -330,11 +1281,107 @@ bool LCD_getPixel(uint8_t x0, uint8_t y0)
   uint8_t shift = y0 / LCD_COLUMN_HEIGHT;
   shift = abs(shift * LCD_COLUMN_HEIGHT - y0);
 
-  return lcd.buffer[x0 + (y0 / LCD_COLUMN_HEIGHT) * LCD_WIDTH] >> shift & 1;
+  return lcd.target[x0 + (y0 / LCD_COLUMN_HEIGHT) * LCD_WIDTH] >> shift & 1;
 }
 
 /**
- * @brief Draws any line, based on Bresenham's line algorithm.
+ * @brief Combine a mask with one byte of the draw target, honouring the band of the drawing core.
+ *
+ * @param core  core drawing the mask (get_core_num()).
+ * @param index byte in the draw target.
+ * @param mask  pixels to draw.
+ * @param mode  set / clear / xor.
+ */
+static void LCD_drawMask(uint8_t core, uint16_t index, uint8_t mask, enum LCD_drawMode mode)
+{
+  uint8_t y0 = index / LCD_WIDTH * LCD_COLUMN_HEIGHT;
+
+  if (y0 < bandTop[core] || y0 >= bandBottom[core])
+    return;
+
+  if (mode == LCD_DRAW_SET)
+    lcd.target[index] |= mask;
+  else if (mode == LCD_DRAW_CLEAR)
+    lcd.target[index] &= ~mask;
+  else
+    lcd.target[index] ^= mask;
+
+  lcd.targetDirty |= 1 << (y0 / LCD_COLUMN_HEIGHT);
+}
+
+/**
+ * @brief Plot many points, one buffer write per touched byte.
+ *        Points are collected in per-byte masks first, bytes are listed when their mask
+ *        gets the first point, then every listed mask is combined with the buffer once.
+ *
+ * @param points  packed points (LCD_PACK_POINT()).
+ * @param count   number of points.
+ * @param mode    set / clear / xor.
+ */
+static void LCD_plotPixels(const uint16_t *points, uint16_t count, enum LCD_drawMode mode)
+{
+  uint8_t core = get_core_num();
+  uint16_t touched = 0;
+
+  for (uint16_t i = 0; i < count; i++)
+  {
+    uint8_t x0 = points[i];
+    uint8_t y0 = points[i] >> 8;
+    uint8_t row = y0 / LCD_COLUMN_HEIGHT;
+    uint16_t index = row * LCD_WIDTH + x0;
+
+    if (x0 >= LCD_WIDTH || y0 >= LCD_HEIGHT)
+      continue;
+
+    STATS_PIXEL(core);
+
+    if (!pixelMask[index])
+    {
+      pixelTouched[touched++] = index;
+
+      if (x0 < dirtyLeft[row])
+        dirtyLeft[row] = x0;
+      if (x0 >= dirtyRight[row])
+        dirtyRight[row] = x0 + 1;
+    }
+
+    pixelMask[index] |= 1 << (y0 % LCD_COLUMN_HEIGHT);
+  }
+
+  for (uint16_t i = 0; i < touched; i++)
+  {
+    LCD_drawMask(core, pixelTouched[i], pixelMask[pixelTouched[i]], mode);
+    pixelMask[pixelTouched[i]] = 0;
+  }
+}
+
+/**
+ * @brief Sets or clears many pixels at once, faster than LCD_setPixel() for each one.
+ *        Points outside of the screen are skipped. Changed columns are sent by LCD_refreshDirty().
+ *
+ * @param points  packed points (LCD_PACK_POINT()).
+ * @param count   number of points.
+ * @param mode    true = lit pixels / false = dim pixels.
+ */
+void LCD_setPixels(const uint16_t *points, uint16_t count, bool mode)
+{
+  LCD_plotPixels(points, count, mode ? LCD_DRAW_SET : LCD_DRAW_CLEAR);
+}
+
+/**
+ * @brief Inverts many pixels at once, a point listed more than once is inverted once.
+ *        Points outside of the screen are skipped. Changed columns are sent by LCD_refreshDirty().
+ *
+ * @param points  packed points (LCD_PACK_POINT()).
+ * @param count   number of points.
+ */
+void LCD_togglePixels(const uint16_t *points, uint16_t count)
+{
+  LCD_plotPixels(points, count, LCD_DRAW_XOR);
+}
+
+/**
+ * @brief Draws any line, based on Bresenham's line algorithm (run-slice, see LCD_drawLineOp()).
  *
  * @param x0 starting point on the x-axis.
  * @param y0 starting point on the y-axis.
@@ -343,31 +1390,189 @@ bool LCD_getPixel(uint8_t x0, uint8_t y0)
  */
 void LCD_drawLine(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
 {
-  uint8_t dx = abs(x1 - x0);
-  uint8_t dy = abs(y1 - y0);
+  LCD_drawLineOp(x0, y0, x1, y1, LCD_DRAW_SET);
+}
+
+/**
+ * @brief Line being drawn, byte whose mask is being collected.
+ */
+struct LCD_lineRun
+{
+  uint8_t core;
+  enum LCD_drawMode mode;
+  uint16_t index;
+  uint8_t mask;
+};
+
+/**
+ * @brief Add pixels to the line, the collected mask is written when the line leaves its byte.
+ *        Masks for the same byte in a row (points moved to the edge) are combined, so xor toggles them once.
+ *
+ * @param line  line being drawn.
+ * @param index byte in the draw target.
+ * @param mask  pixels in the byte.
+ */
+static void LCD_lineMask(struct LCD_lineRun *line, uint16_t index, uint8_t mask)
+{
+  if (index != line->index)
+  {
+    if (line->mask)
+      LCD_drawMask(line->core, line->index, line->mask, line->mode);
+    line->index = index;
+    line->mask = 0;
+  }
+
+  line->mask |= mask;
+}
+
+/**
+ * @brief Draw a horizontal run of a line, every pixel is a byte of its own.
+ *
+ * @param line    line being drawn.
+ * @param x0      first pixel on the x-axis.
+ * @param y0      run position on the y-axis.
+ * @param length  number of pixels.
+ * @param sx      direction on the x-axis.
+ */
+static void LCD_lineRunX(struct LCD_lineRun *line, uint8_t x0, uint8_t y0, uint16_t length, int8_t sx)
+{
+  uint8_t y = y0 < LCD_HEIGHT ? y0 : LCD_HEIGHT - 1;
+  uint16_t base = (y / LCD_COLUMN_HEIGHT) * LCD_WIDTH;
+  uint8_t mask = 1 << (y % LCD_COLUMN_HEIGHT);
+
+  for (uint16_t i = 0; i < length; i++, x0 += sx)
+    LCD_lineMask(line, base + (x0 < LCD_WIDTH ? x0 : LCD_WIDTH - 1), mask);
+}
+
+/**
+ * @brief Draw a vertical run of a line, one mask per byte it crosses.
+ *
+ * @param line    line being drawn.
+ * @param x0      run position on the x-axis.
+ * @param y0      first pixel on the y-axis.
+ * @param length  number of pixels.
+ * @param sy      direction on the y-axis.
+ */
+static void LCD_lineRunY(struct LCD_lineRun *line, uint8_t x0, uint8_t y0, uint16_t length, int8_t sy)
+{
+  uint8_t x = x0 < LCD_WIDTH ? x0 : LCD_WIDTH - 1;
+  int16_t top = sy > 0 ? y0 : y0 - length + 1;
+  int16_t bottom = top + length - 1;
+
+  if (top >= LCD_HEIGHT)
+    top = LCD_HEIGHT - 1;
+  if (bottom >= LCD_HEIGHT)
+    bottom = LCD_HEIGHT - 1;
+
+  // Bytes are visited in the direction of the line, so the byte shared with the next run is still collected
+  int8_t first = (sy > 0 ? top : bottom) / LCD_COLUMN_HEIGHT;
+  int8_t last = (sy > 0 ? bottom : top) / LCD_COLUMN_HEIGHT;
+
+  for (int8_t row = first;; row += sy)
+  {
+    uint8_t from = top > row * LCD_COLUMN_HEIGHT ? top % LCD_COLUMN_HEIGHT : 0;
+    uint8_t to = bottom < (row + 1) * LCD_COLUMN_HEIGHT ? bottom % LCD_COLUMN_HEIGHT : LCD_COLUMN_HEIGHT - 1;
+
+    LCD_lineMask(line, row * LCD_WIDTH + x, (0xFF << from) & (0xFF >> (LCD_COLUMN_HEIGHT - 1 - to)));
+
+    if (row == last)
+      break;
+  }
+}
+
+/**
+ * @brief Walk a line run by run, based on Bresenham's line algorithm.
+ *        Run-slice: the length of every run along the major axis is computed from the error term,
+ *        giving the same pixels as stepping pixel by pixel. Shared by all line drawing functions,
+ *        the callback draws each run in its own target.
+ *
+ * @param x0      starting point on the x-axis.
+ * @param y0      starting point on the y-axis.
+ * @param x1      ending point on the x-axis.
+ * @param y1      ending point on the y-axis.
+ * @param run     called for every run, from start to end.
+ * @param context passed to run.
+ */
+void LCD_lineRuns(int16_t x0, int16_t y0, int16_t x1, int16_t y1, LCD_lineRunCallback run, void *context)
+{
+  int32_t dx = abs(x1 - x0);
+  int32_t dy = abs(y1 - y0);
   int8_t sx = x0 < x1 ? 1 : -1;
   int8_t sy = y0 < y1 ? 1 : -1;
-  int8_t err = dx - dy;
-  int16_t e2;
+  int32_t err = dx - dy;
+  int32_t x = x0, y = y0;
+  int32_t left = (dx >= dy ? dx : dy) + 1;
+  int32_t steps, length;
 
-  while (x0 != x1 || y0 != y1)
+  while (left)
   {
-    LCD_setPixel(x0, y0, true);
-
-    e2 = 2 * err;
-    if (e2 > -dy)
+    if (dx >= dy)
     {
-      err -= dy;
-      x0 += sx;
+      // Minor step comes at the first pixel with 2 * err < dx, every major step takes dy from err
+      steps = !dy ? left - 1 : 2 * err >= dx ? (2 * err - dx) / (2 * dy) + 1 : 0;
+      length = steps + 1 < left ? steps + 1 : left;
+
+      run(context, x, y, length, true, sx);
+      x += length * sx;
+      y += sy;
+      err += dx - (steps + 1) * dy;
     }
-    if (e2 < dx)
+    else
     {
-      err += dx;
-      y0 += sy;
+      // Minor step comes at the first pixel with 2 * err > -dy, every major step adds dx to err
+      steps = !dx ? left - 1 : 2 * err <= -dy ? (-dy - 2 * err) / (2 * dx) + 1 : 0;
+      length = steps + 1 < left ? steps + 1 : left;
+
+      run(context, x, y, length, false, sy);
+      y += length * sy;
+      x += sx;
+      err += (steps + 1) * dx - dy;
     }
+
+    left -= length;
   }
+}
 
-  LCD_setPixel(x0, y0, true);
+/**
+ * @brief Draw a run of a line in the draw target, LCD_lineRuns() callback.
+ *        Horizontal runs write every pixel in a byte of its own, vertical runs one mask per byte they cross.
+ */
+static void LCD_lineDrawRun(void *context, int16_t x0, int16_t y0, uint32_t length, bool horizontal, int8_t step)
+{
+  struct LCD_lineRun *line = context;
+
+  STATS_PIXELS(line->core, length);
+
+  if (horizontal)
+    LCD_lineRunX(line, x0, y0, length, step);
+  else
+    LCD_lineRunY(line, x0, y0, length, step);
+}
+
+/**
+ * @brief Draws any line with given mode, run by run (LCD_lineRuns()).
+ *        Vertical runs are written one mask per byte, so a steep line touches every byte once.
+ *        Drawing the same line twice in xor mode erases it.
+ *        Points past the screen edge are moved to the edge, as in LCD_setPixel().
+ *
+ * @param x0    starting point on the x-axis.
+ * @param y0    starting point on the y-axis.
+ * @param x1    ending point on the x-axis.
+ * @param y1    ending point on the y-axis.
+ * @param mode  set / clear / xor.
+ */
+void LCD_drawLineOp(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, enum LCD_drawMode mode)
+{
+  struct LCD_lineRun line = {get_core_num(), mode, UINT16_MAX, 0};
+
+  STATS_PRIMITIVE_BEGIN(line.core, LCD_PRIMITIVE_LINE);
+
+  LCD_lineRuns(x0, y0, x1, y1, LCD_lineDrawRun, &line);
+
+  if (line.mask)
+    LCD_drawMask(line.core, line.index, line.mask, line.mode);
+
+  STATS_PRIMITIVE_END();
 }
 
 /**
@@ -380,10 +1585,14 @@ void LCD_drawLine(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
  */
 void LCD_drawRectangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
 {
+  STATS_PRIMITIVE_BEGIN(get_core_num(), LCD_PRIMITIVE_RECTANGLE);
+
   LCD_drawLine(x0, y0, x1, y0);
   LCD_drawLine(x0, y0, x0, y1);
   LCD_drawLine(x1, y0, x1, y1);
   LCD_drawLine(x0, y1, x1, y1);
+
+  STATS_PRIMITIVE_END();
 }
 
 /**
@@ -398,9 +1607,13 @@ void LCD_drawRectangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
  */
 void LCD_drawTriangle(uint8_t xA, uint8_t yA, uint8_t xB, uint8_t yB, uint8_t xC, uint8_t yC)
 {
+  STATS_PRIMITIVE_BEGIN(get_core_num(), LCD_PRIMITIVE_TRIANGLE);
+
   LCD_drawLine(xA, yA, xB, yB);
   LCD_drawLine(xB, yB, xC, yC);
   LCD_drawLine(xC, yC, xA, yA);
+
+  STATS_PRIMITIVE_END();
 }
 
 /**
@@ -412,20 +1625,24 @@ void LCD_drawTriangle(uint8_t xA, uint8_t yA, uint8_t xB, uint8_t yB, uint8_t xC
  */
 void LCD_drawCircle(uint8_t x0, uint8_t y0, uint8_t radius)
 {
+  uint8_t core = get_core_num();
+
+  STATS_PRIMITIVE_BEGIN(core, LCD_PRIMITIVE_CIRCLE);
+
   int8_t x = radius;
   int8_t y = 0;
   int8_t err = 0;
 
   while (x >= y)
   {
-    LCD_setPixel(x0 + x, y0 + y, true);
-    LCD_setPixel(x0 + y, y0 + x, true);
-    LCD_setPixel(x0 - y, y0 + x, true);
-    LCD_setPixel(x0 - x, y0 + y, true);
-    LCD_setPixel(x0 - x, y0 - y, true);
-    LCD_setPixel(x0 - y, y0 - x, true);
-    LCD_setPixel(x0 + y, y0 - x, true);
-    LCD_setPixel(x0 + x, y0 - y, true);
+    LCD_plotPixel(core, x0 + x, y0 + y, true);
+    LCD_plotPixel(core, x0 + y, y0 + x, true);
+    LCD_plotPixel(core, x0 - y, y0 + x, true);
+    LCD_plotPixel(core, x0 - x, y0 + y, true);
+    LCD_plotPixel(core, x0 - x, y0 - y, true);
+    LCD_plotPixel(core, x0 - y, y0 - x, true);
+    LCD_plotPixel(core, x0 + y, y0 - x, true);
+    LCD_plotPixel(core, x0 + x, y0 - y, true);
 
     if (err <= 0)
     {
@@ -438,28 +1655,49 @@ void LCD_drawCircle(uint8_t x0, uint8_t y0, uint8_t radius)
       err -= 2 * x + 1;
     }
   }
+
+  STATS_PRIMITIVE_END();
 }
 
 /**
- * @brief Change pixel state inside closed shape.
- * Uses flood fill algorithm.
+ * @brief Flood fill step.
  *
- * @param x0    any point on x axis inside the shape.
- * @param y0    any point on y axis inside the shape.
+ * @param core  core drawing the shape (get_core_num()).
+ * @param x0    point on x axis.
+ * @param y0    point on y axis.
  * @param mode  true = lit pixel / false = dim pixel.
  */
-void LCD_fillShape(int8_t x0, int8_t y0, bool mode)
+static void LCD_fill(uint8_t core, int8_t x0, int8_t y0, bool mode)
 {
   // If out of bounds or pixel does not match, stop
   if (x0 < 0 || x0 >= LCD_WIDTH || y0 < 0 || y0 >= LCD_HEIGHT || LCD_getPixel(x0, y0) == mode)
     return;
 
   // Set current cell (pixel)
-  LCD_setPixel(x0, y0, mode);
+  LCD_plotPixel(core, x0, y0, mode);
 
   // Recursively fill the neighboring cells
-  LCD_fillShape(x0 - 1, y0, mode); // Up
-  LCD_fillShape(x0 + 1, y0, mode); // Down
-  LCD_fillShape(x0, y0 - 1, mode); // Left
-  LCD_fillShape(x0, y0 + 1, mode); // Right
+  LCD_fill(core, x0 - 1, y0, mode); // Up
+  LCD_fill(core, x0 + 1, y0, mode); // Down
+  LCD_fill(core, x0, y0 - 1, mode); // Left
+  LCD_fill(core, x0, y0 + 1, mode); // Right
+}
+
+/**
+ * @brief Change pixel state inside closed shape.
+ * Uses flood fill algorithm.
+ *
+ * @param x0    any point on x axis inside the shape.
+ * @param y0    any point on y axis inside the shape.
+ * @param mode  true = lit pixel / false = dim pixel.
+ */
+void LCD_fillShape(int8_t x0, int8_t y0, bool mode)
+{
+  uint8_t core = get_core_num();
+
+  STATS_PRIMITIVE_BEGIN(core, LCD_PRIMITIVE_FILL);
+
+  LCD_fill(core, x0, y0, mode);
+
+  STATS_PRIMITIVE_END();
 }
\ No newline at end of file
@@ -24,20 +24,69 @@
 
 #define LCD_SPI_MAX_SPEED 4000000
 
+// Set to 1 (e.g. with target_compile_definitions) to collect performance counters
+#ifndef LCD_ENABLE_STATS
+#define LCD_ENABLE_STATS 0
+#endif
+
+// Set to 1 to keep a shadow copy of the panel's display RAM (LCD_getShadow(), frame capture)
+#ifndef LCD_ENABLE_SHADOW
+#define LCD_ENABLE_SHADOW 0
+#endif
+
 #define LCD_SETYADDR 0x40
 #define LCD_SETXADDR 0x80
 #define LCD_DISPLAY_BLANK 0x08
 #define LCD_DISPLAY_NORMAL 0x0C
 #define LCD_DISPLAY_ALL_ON 0x09
 #define LCD_DISPLAY_INVERTED 0x0D
+#define LCD_FUNCTION_SET 0x20
+#define LCD_VERTICAL_ADDRESSING 0x02
+#define LCD_EXTENDED_INSTRUCTIONS 0x01
+
+// Extended instruction set
+#define LCD_SET_TEMPERATURE 0x04
+#define LCD_SET_BIAS 0x10
+#define LCD_SET_VOP 0x80
 
 #define LCD_COLUMN_HEIGHT 8
 #define LCD_ROW_NUMBER 6
-#define LCD_LETTERS_IN_ROW LCD_WIDTH / FONT_SYMBOL_WIDTH
+#define LCD_LETTERS_IN_ROW (LCD_WIDTH / FONT_SYMBOL_WIDTH)
+
+#define LCD_TEXT_MAX_SCALE 4
+
+// Point for LCD_setPixels() / LCD_togglePixels()
+#define LCD_PACK_POINT(x, y) ((uint16_t)((y) << 8 | (x)))
 
 #define LCD_WIDTH 84
 #define LCD_HEIGHT 48
-#define LCD_SIZE (LCD_WIDTH * LCD_HEIGHT) / LCD_COLUMN_HEIGHT
+#define LCD_SIZE ((LCD_WIDTH * LCD_HEIGHT) / LCD_COLUMN_HEIGHT)
+
+#define LCD_PORTRAIT_WIDTH LCD_HEIGHT
+#define LCD_PORTRAIT_HEIGHT LCD_WIDTH
+#define LCD_PORTRAIT_BANKS ((LCD_PORTRAIT_HEIGHT + LCD_COLUMN_HEIGHT - 1) / LCD_COLUMN_HEIGHT)
+#define LCD_PORTRAIT_SIZE (LCD_PORTRAIT_WIDTH * LCD_PORTRAIT_BANKS)
+
+/**
+ * @brief Orientation of the picture on the panel (clockwise).
+ */
+enum LCD_rotation
+{
+	LCD_ROTATE_0,
+	LCD_ROTATE_90,
+	LCD_ROTATE_180,
+	LCD_ROTATE_270
+};
+
+/**
+ * @brief How drawn pixels are combined with the buffer.
+ */
+enum LCD_drawMode
+{
+	LCD_DRAW_SET,
+	LCD_DRAW_CLEAR,
+	LCD_DRAW_XOR
+};
 
 /**
  * @brief LCD parameters
@@ -45,10 +94,30 @@
 struct LCD_att
 {
 	spi_inst_t *spi;
-	uint8_t buffer[LCD_SIZE];
+	uint8_t buffer[LCD_SIZE] __attribute__((aligned(4)));
+	uint8_t *target;
+	uint8_t targetDirty;
 	bool invertText;
+	bool smoothText;
+	enum LCD_rotation rotation;
+	bool mirrorX;
+	bool mirrorY;
 };
 
+/**
+ * @brief Panel configuration for LCD_initConfig().
+ */
+struct LCD_config
+{
+	uint8_t contrast;	 // Vop, 0 - 127
+	uint8_t bias;		 // bias system, 0 - 7 (4 = 1:40)
+	uint8_t temperature; // temperature coefficient, 0 - 3
+	const uint8_t *splash; // first frame in lcd.buffer layout (e.g. in flash), NULL = blank screen
+};
+
+// Values used by LCD_init()
+#define LCD_CONFIG_DEFAULT {0x38, 0x04, 0x00, NULL}
+
 /**
  * @brief GPIO ports used
  */
@@ -61,6 +130,87 @@ struct LCD_GPIO
 	uint16_t SCLK;
 };
 
+/**
+ * @brief Library calls performance counters are attributed to.
+ */
+enum LCD_statsApi
+{
+	LCD_API_INIT,
+	LCD_API_TEXT,
+	LCD_API_CLEAR,
+	LCD_API_REFRESH,
+	LCD_API_CONTROL,
+	LCD_API_OTHER,
+	LCD_API_COUNT
+};
+
+/**
+ * @brief Draw functions pixel counters are attributed to.
+ */
+enum LCD_statsPrimitive
+{
+	LCD_PRIMITIVE_PIXEL,
+	LCD_PRIMITIVE_LINE,
+	LCD_PRIMITIVE_RECTANGLE,
+	LCD_PRIMITIVE_TRIANGLE,
+	LCD_PRIMITIVE_CIRCLE,
+	LCD_PRIMITIVE_FILL,
+	LCD_PRIMITIVE_COUNT
+};
+
+// Refresh latency histogram, bucket n counts refreshes shorter than (64 << n) us, last one the rest
+#define LCD_STATS_HISTOGRAM_SIZE 12
+#define LCD_STATS_HISTOGRAM_BASE_US 64
+
+/**
+ * @brief SPI traffic counters.
+ */
+struct LCD_trafficStats
+{
+	uint32_t bytes;
+	uint32_t commands;
+	uint32_t transactions;
+	uint32_t blockedUs;
+};
+
+/**
+ * @brief Performance counters, collected when LCD_ENABLE_STATS is set.
+ */
+struct LCD_stats
+{
+	struct LCD_trafficStats total;
+	struct LCD_trafficStats api[LCD_API_COUNT];
+	uint32_t csToggles;
+	uint32_t goXY;
+	uint32_t pixels[LCD_PRIMITIVE_COUNT];
+	uint32_t refreshes;
+	uint32_t refreshTotalUs;
+	uint32_t refreshMaxUs;
+	uint32_t refreshHistogram[LCD_STATS_HISTOGRAM_SIZE];
+};
+
+/**
+ * @brief Panel state decoded from the commands and data sent, collected when LCD_ENABLE_SHADOW is set.
+ */
+struct LCD_shadow
+{
+	uint8_t ram[LCD_SIZE];
+	uint8_t x;
+	uint8_t y;
+	bool extended;
+	bool vertical;
+	uint8_t display;
+};
+
+/**
+ * @brief Run of a line passed by LCD_lineRuns(): length pixels from x0, y0 along the major axis.
+ *        horizontal = run along the x-axis, step = direction along the run (1 / -1).
+ */
+typedef void (*LCD_lineRunCallback)(void *context, int16_t x0, int16_t y0, uint32_t length, bool horizontal, int8_t step);
+
+// Bit reversal lookup, flips a bank byte upside down (shared by modules sending mirrored frames)
+extern const uint8_t lcd_bitReverse[256];
+
 /*----- SPI CONF ------*/
 
 void LCD_setSPIInstance(spi_inst_t *spi);
@@ -73,35 +223,72 @@ void LCD_setDC(uint16_t PIN);
 void LCD_setDIN(uint16_t PIN);
 void LCD_setSCLK(uint16_t PIN);
 
+/*----- Low level Functions -----*/
+
+void LCD_writeCommand(uint8_t command);
+void LCD_writeData(const uint8_t *data, uint16_t size);
+
 /*----- Library Functions -----*/
 
 void LCD_init();
+uint32_t LCD_initConfig(const struct LCD_config *config);
 void LCD_invert(bool mode);
 void LCD_invertText(bool mode);
 void LCD_putChar(char c);
 void LCD_print(char *str, uint8_t x0, uint8_t row);
 void LCD_printCenter(char *str, uint8_t length, uint8_t row);
+void LCD_smoothText(bool mode);
 void LCD_clrScr();
 void LCD_goXY(uint8_t x0, uint8_t row);
+void LCD_setRotation(enum LCD_rotation rotation);
+void LCD_setMirror(bool horizontal, bool vertical);
+void LCD_setBand(uint8_t row, uint8_t nRow);
+void LCD_setDrawTarget(uint8_t *frame);
 
 /*---- Helper functions -----*/
 
 bool LCD_getPixel(uint8_t x0, uint8_t y0);
+void LCD_transpose8(const uint8_t *src, uint16_t srcStride, uint8_t *dst, uint16_t dstStride);
+
+/*----- Statistics -----*/
+
+const struct LCD_stats *LCD_getStats();
+void LCD_resetStats();
+void LCD_printStats();
+
+/*----- Shadow -----*/
+
+const struct LCD_shadow *LCD_getShadow();
 
 /*----- Draw Functions -----*/
 /*
  * These functions draw in a buffer variable. It's necessary to use LCD_refreshScr() or LCD_refreshArea()
  * in order to send data to the LCD.
+ * LCD_setDrawTarget() redirects drawing to another frame (e.g. a layer), rows drawn in
+ * are marked in lcd.targetDirty.
  */
 
 void LCD_clrBuff();
 void LCD_refreshScr();
 void LCD_refreshArea(uint8_t x0, uint8_t x1, uint8_t row, uint8_t nRow);
+void LCD_refreshColumn(uint8_t x0, uint8_t row, uint8_t nRow);
+uint32_t LCD_refreshPortrait(const uint8_t *frame);
+void LCD_refreshFrame(const uint8_t *frame);
+uint8_t *LCD_getStreamBuffer();
+bool LCD_refreshStep(uint32_t budgetUs);
+void LCD_refreshStepReset();
+void LCD_refreshDirty();
 void LCD_setPixel(uint8_t x0, uint8_t y0, bool mode);
+void LCD_setPixels(const uint16_t *points, uint16_t count, bool mode);
+void LCD_togglePixels(const uint16_t *points, uint16_t count);
 void LCD_drawLine(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+void LCD_drawLineOp(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, enum LCD_drawMode mode);
+void LCD_lineRuns(int16_t x0, int16_t y0, int16_t x1, int16_t y1, LCD_lineRunCallback run, void *context);
 void LCD_drawRectangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
 void LCD_drawTriangle(uint8_t xA, uint8_t yA, uint8_t xB, uint8_t yB, uint8_t xC, uint8_t yC);
 void LCD_drawCircle(uint8_t x0, uint8_t y0, uint8_t radius);
 void LCD_fillShape(int8_t x0, int8_t y0, bool mode);
+void LCD_putCharScaled(char c, uint8_t x0, uint8_t row, uint8_t scale);
+void LCD_printScaled(char *str, uint8_t x0, uint8_t row, uint8_t scale);
 
 #endif
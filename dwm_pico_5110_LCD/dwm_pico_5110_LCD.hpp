@@ -0,0 +1,598 @@
+/*
+ * File: dwm_pico_5110_LCD.hpp
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+/*
+ * Header only C++17 version of the library.
+ *
+ * Panel geometry is a template parameter, so buffer size, bank math and loops
+ * are known at compile time. Transfers go through a bus policy:
+ *
+ *   SpiBus   - blocking SPI, same as the C library.
+ *   DmaBus   - SPI fed by DMA, data transfers return immediately (link hardware_dma).
+ *   HostBus  - no hardware, emulates controller's memory (for host builds).
+ *
+ * A bus policy provides: init(), reset(), command(uint8_t), data(const uint8_t *, size_t), wait().
+ *
+ * Example:
+ *   dwm::Pcd8544<dwm::SpiBus> lcd(dwm::SpiBus(spi1, SCE_PIN, DC_PIN, RST_PIN, DIN_PIN, SCLK_PIN));
+ *   lcd.init();
+ *   lcd.drawLine(0, 0, 83, 47);
+ *   lcd.refresh();
+ */
+
+#ifndef DWM_PICO_5110_LCD_HPP
+#define DWM_PICO_5110_LCD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "font.h"
+
+#if __has_include("hardware/spi.h")
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "hardware/gpio.h"
+#include "hardware/dma.h"
+#define DWM_PICO_5110_LCD_HAS_SPI 1
+#endif
+
+namespace dwm
+{
+  /**
+   * @brief Controller commands.
+   */
+  namespace pcd8544
+  {
+    constexpr uint8_t functionSet = 0x20;
+    constexpr uint8_t extendedInstructions = 0x01;
+    constexpr uint8_t verticalAddressing = 0x02;
+    constexpr uint8_t setYAddr = 0x40;
+    constexpr uint8_t setXAddr = 0x80;
+    constexpr uint8_t setVop = 0x80;
+    constexpr uint8_t setTempCoefficient = 0x04;
+    constexpr uint8_t setBias = 0x10;
+    constexpr uint8_t displayBlank = 0x08;
+    constexpr uint8_t displayNormal = 0x0C;
+    constexpr uint8_t displayAllOn = 0x09;
+    constexpr uint8_t displayInverted = 0x0D;
+    constexpr uint32_t maxSpeed = 4000000;
+  }
+
+  /**
+   * @brief Geometry of font.h glyphs.
+   */
+  struct Font
+  {
+    static constexpr uint8_t width = FONT_SYMBOL_WIDTH;
+    static constexpr uint8_t first = 0x20;
+    static constexpr size_t count = sizeof(ASCII) / sizeof(ASCII[0]);
+
+    using Table = std::array<std::array<uint8_t, width>, count>;
+  };
+
+  /**
+   * @brief Build glyph table from font.h at compile time.
+   *
+   * @param inverted true = glyphs for inverted text.
+   */
+  constexpr Font::Table makeFont(bool inverted)
+  {
+    Font::Table table{};
+
+    for (size_t i = 0; i < Font::count; i++)
+      for (size_t j = 0; j < Font::width; j++)
+        table[i][j] = inverted ? static_cast<uint8_t>(~ASCII[i][j]) : ASCII[i][j];
+
+    return table;
+  }
+
+  inline constexpr Font::Table font = makeFont(false);
+  inline constexpr Font::Table fontInverted = makeFont(true);
+
+  /**
+   * @brief Bus without hardware, emulates controller's display memory.
+   *
+   * @tparam Columns  controller memory width.
+   * @tparam Banks    controller memory height in 8 pixel banks.
+   */
+  template <uint8_t Columns = 84, uint8_t Banks = 6>
+  class HostBus
+  {
+  public:
+    std::array<uint8_t, Columns * Banks> ram{};
+    size_t bytes = 0;
+    size_t transactions = 0;
+
+    void init() {}
+
+    void reset()
+    {
+      ram.fill(0);
+      x_ = y_ = 0;
+      extended_ = vertical_ = false;
+    }
+
+    void command(uint8_t command)
+    {
+      bytes++;
+      transactions++;
+
+      if ((command & 0xF8) == pcd8544::functionSet)
+      {
+        extended_ = command & pcd8544::extendedInstructions;
+        vertical_ = command & pcd8544::verticalAddressing;
+      }
+      else if (!extended_ && (command & pcd8544::setXAddr))
+        x_ = command & 0x7F;
+      else if (!extended_ && (command & 0xC0) == pcd8544::setYAddr)
+        y_ = command & 0x07;
+    }
+
+    void data(const uint8_t *data, size_t size)
+    {
+      bytes += size;
+      transactions++;
+
+      for (size_t i = 0; i < size; i++)
+      {
+        if (x_ < Columns && y_ < Banks)
+          ram[y_ * Columns + x_] = data[i];
+
+        // Address wraps the same way as on the controller
+        if (vertical_)
+        {
+          if (++y_ >= Banks)
+          {
+            y_ = 0;
+            x_ = x_ + 1 >= Columns ? 0 : x_ + 1;
+          }
+        }
+        else if (++x_ >= Columns)
+        {
+          x_ = 0;
+          y_ = y_ + 1 >= Banks ? 0 : y_ + 1;
+        }
+      }
+    }
+
+    void wait() {}
+
+  private:
+    uint8_t x_ = 0;
+    uint8_t y_ = 0;
+    bool extended_ = false;
+    bool vertical_ = false;
+  };
+
+#ifdef DWM_PICO_5110_LCD_HAS_SPI
+  /**
+   * @brief Blocking SPI bus.
+   */
+  class SpiBus
+  {
+  public:
+    /**
+     * @param spi   spi interface (spi0 or spi1), initialised by the user.
+     * @param sce   SCE (slave chip enable) pin.
+     * @param dc    D/C (data / command select) pin.
+     * @param rst   RST (reset) pin.
+     * @param din   DIN (data in) pin.
+     * @param sclk  SCLK (serial clock) pin.
+     */
+    SpiBus(spi_inst_t *spi, uint sce, uint dc, uint rst, uint din, uint sclk)
+        : spi_(spi), sce_(sce), dc_(dc), rst_(rst), din_(din), sclk_(sclk) {}
+
+    void init()
+    {
+      gpio_init(sce_);
+      gpio_set_dir(sce_, GPIO_OUT);
+      gpio_put(sce_, true);
+
+      gpio_init(rst_);
+      gpio_set_dir(rst_, GPIO_OUT);
+
+      gpio_init(dc_);
+      gpio_set_dir(dc_, GPIO_OUT);
+
+      gpio_set_function(din_, GPIO_FUNC_SPI);
+      gpio_set_function(sclk_, GPIO_FUNC_SPI);
+    }
+
+    void reset()
+    {
+      gpio_put(rst_, false);
+      sleep_us(1);
+      gpio_put(rst_, true);
+    }
+
+    void command(uint8_t command)
+    {
+      gpio_put(dc_, false);
+      gpio_put(sce_, false);
+      spi_write_blocking(spi_, &command, 1);
+      gpio_put(sce_, true);
+    }
+
+    void data(const uint8_t *data, size_t size)
+    {
+      gpio_put(dc_, true);
+      gpio_put(sce_, false);
+      spi_write_blocking(spi_, data, size);
+      gpio_put(sce_, true);
+    }
+
+    void wait() {}
+
+  protected:
+    spi_inst_t *spi_;
+    uint sce_;
+    uint dc_;
+    uint rst_;
+    uint din_;
+    uint sclk_;
+  };
+
+  /**
+   * @brief SPI bus fed by DMA. Data transfers return as soon as they are started,
+   *        sent data must stay untouched until wait() (or the next transfer).
+   */
+  class DmaBus : public SpiBus
+  {
+  public:
+    using SpiBus::SpiBus;
+
+    void init()
+    {
+      SpiBus::init();
+
+      channel_ = dma_claim_unused_channel(true);
+      config_ = dma_channel_get_default_config(channel_);
+      channel_config_set_transfer_data_size(&config_, DMA_SIZE_8);
+      channel_config_set_dreq(&config_, spi_get_dreq(spi_, true));
+      channel_config_set_read_increment(&config_, true);
+      channel_config_set_write_increment(&config_, false);
+    }
+
+    void command(uint8_t command)
+    {
+      wait();
+      SpiBus::command(command);
+    }
+
+    void data(const uint8_t *data, size_t size)
+    {
+      wait();
+
+      gpio_put(dc_, true);
+      gpio_put(sce_, false);
+      dma_channel_configure(channel_, &config_, &spi_get_hw(spi_)->dr, data, size, true);
+      busy_ = true;
+    }
+
+    void wait()
+    {
+      if (!busy_)
+        return;
+
+      // DMA finishes when the last byte enters the FIFO, SPI has to shift it out
+      dma_channel_wait_for_finish_blocking(channel_);
+      while (spi_is_busy(spi_))
+        tight_loop_contents();
+
+      gpio_put(sce_, true);
+      busy_ = false;
+    }
+
+  private:
+    uint channel_ = 0;
+    dma_channel_config config_{};
+    bool busy_ = false;
+  };
+#endif
+
+  /**
+   * @brief PCD8544 (Nokia 5110) driver with compile time geometry.
+   *
+   * @tparam Bus    bus policy.
+   * @tparam Width  panel width in pixels (controller supports up to 128).
+   * @tparam Height panel height in pixels (controller supports up to 8 banks).
+   */
+  template <class Bus, uint8_t Width = 84, uint8_t Height = 48>
+  class Pcd8544
+  {
+  public:
+    static constexpr uint8_t width = Width;
+    static constexpr uint8_t height = Height;
+    static constexpr uint8_t bankHeight = 8;
+    static constexpr uint8_t banks = (Height + bankHeight - 1) / bankHeight;
+    static constexpr size_t size = static_cast<size_t>(Width) * banks;
+    static constexpr uint8_t lettersInRow = Width / Font::width;
+
+    static_assert(Width > 0 && Width <= 128, "X address is 7 bits wide");
+    static_assert(banks > 0 && banks <= 8, "Y address is 3 bits wide");
+
+    using Buffer = std::array<uint8_t, size>;
+
+    /**
+     * @brief Buffer index of a pixel.
+     */
+    static constexpr size_t index(uint8_t x, uint8_t y)
+    {
+      return x + static_cast<size_t>(y / bankHeight) * Width;
+    }
+
+    /**
+     * @brief Bit mask of a pixel inside its buffer byte.
+     */
+    static constexpr uint8_t mask(uint8_t y)
+    {
+      return 1 << (y % bankHeight);
+    }
+
+    explicit Pcd8544(const Bus &bus) : bus_(bus) {}
+
+    /**
+     * @brief Initialize the LCD.
+     *
+     * @attention Must initialise SPI first! Max supported speed is 4MHZ (pcd8544::maxSpeed).
+     *
+     * @param vop         operating voltage (contrast), 0 - 127.
+     * @param bias        bias system, 0 - 7.
+     * @param temperature temperature coefficient, 0 - 3.
+     */
+    void init(uint8_t vop = 0x38, uint8_t bias = 4, uint8_t temperature = 0)
+    {
+      bus_.init();
+      bus_.reset();
+
+      bus_.command(pcd8544::functionSet | pcd8544::extendedInstructions);
+      bus_.command(pcd8544::setVop | (vop & 0x7F));
+      bus_.command(pcd8544::setTempCoefficient | (temperature & 0x03));
+      bus_.command(pcd8544::setBias | (bias & 0x07));
+      bus_.command(pcd8544::functionSet);
+      bus_.command(pcd8544::displayNormal);
+
+      clrBuff();
+      refresh();
+
+      invertText_ = false;
+    }
+
+    /**
+     * @brief Invert the color shown on the display.
+     */
+    void invert(bool mode)
+    {
+      bus_.command(mode ? pcd8544::displayInverted : pcd8544::displayNormal);
+    }
+
+    /**
+     * @brief Invert the colour of any text sent to the display.
+     */
+    void invertText(bool mode)
+    {
+      invertText_ = mode;
+    }
+
+    /**
+     * @brief Set LCD's cursor to position X,Y.
+     */
+    void goXY(uint8_t x0, uint8_t row)
+    {
+      bus_.command(pcd8544::setXAddr | x0);
+      bus_.command(pcd8544::setYAddr | row);
+    }
+
+    /**
+     * @brief Puts one char on the current position of LCD's cursor.
+     */
+    void putChar(char c)
+    {
+      const Font::Table &glyphs = invertText_ ? fontInverted : font;
+      uint8_t glyph = static_cast<uint8_t>(c) - Font::first;
+
+      bus_.data(glyphs[glyph < Font::count ? glyph : 0].data(), Font::width);
+    }
+
+    /**
+     * @brief Print a string on the LCD.
+     */
+    void print(const char *str, uint8_t x0, uint8_t row)
+    {
+      goXY(x0, row);
+      while (*str)
+        putChar(*str++);
+    }
+
+    /**
+     * @brief Clears buffer.
+     */
+    void clrBuff()
+    {
+      buffer_.fill(0);
+    }
+
+    /**
+     * @brief Updates the entire screen according to buffer and waits for the transfer.
+     */
+    void refresh()
+    {
+      refreshAsync();
+      bus_.wait();
+    }
+
+    /**
+     * @brief Starts updating the entire screen. With DmaBus returns before the transfer ends,
+     *        buffer must not be changed until wait().
+     */
+    void refreshAsync()
+    {
+      goXY(0, 0);
+
+      // Width equal to controller's memory width makes the buffer one continuous transfer
+      if constexpr (Width == 84)
+        bus_.data(buffer_.data(), size);
+      else
+        for (uint8_t row = 0; row < banks; row++)
+        {
+          goXY(0, row);
+          bus_.data(&buffer_[row * Width], Width);
+        }
+    }
+
+    /**
+     * @brief Updates a square of the screen.
+     *
+     * @param x0      starting point on x-axis.
+     * @param x1      ending point on x-axis (exclusive).
+     * @param row     starting row (multiple of 8 lines).
+     * @param nRow    number of rows to refresh.
+     */
+    void refreshArea(uint8_t x0, uint8_t x1, uint8_t row, uint8_t nRow)
+    {
+      if (x1 > Width)
+        x1 = Width;
+      if (row + nRow > banks)
+        nRow = row < banks ? banks - row : 0;
+      if (x0 >= x1 || !nRow)
+        return;
+
+      for (uint8_t i = row; i < row + nRow; i++)
+      {
+        goXY(x0, i);
+        bus_.data(&buffer_[i * Width + x0], x1 - x0);
+      }
+
+      bus_.wait();
+    }
+
+    /**
+     * @brief Wait for the pending transfer.
+     */
+    void wait()
+    {
+      bus_.wait();
+    }
+
+    /**
+     * @brief Sets a pixel, pixels outside the screen are ignored.
+     */
+    void setPixel(uint8_t x0, uint8_t y0, bool mode)
+    {
+      if (x0 >= Width || y0 >= Height)
+        return;
+
+      if (mode)
+        buffer_[index(x0, y0)] |= mask(y0);
+      else
+        buffer_[index(x0, y0)] &= ~mask(y0);
+    }
+
+    /**
+     * @brief Get pixel state in the buffer, pixels outside the screen are dim.
+     */
+    bool getPixel(uint8_t x0, uint8_t y0) const
+    {
+      if (x0 >= Width || y0 >= Height)
+        return false;
+
+      return buffer_[index(x0, y0)] & mask(y0);
+    }
+
+    /**
+     * @brief Draws any line, based on Bresenham's line algorithm.
+     */
+    void drawLine(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+    {
+      int16_t dx = x1 > x0 ? x1 - x0 : x0 - x1;
+      int16_t dy = y1 > y0 ? y1 - y0 : y0 - y1;
+      int8_t sx = x0 < x1 ? 1 : -1;
+      int8_t sy = y0 < y1 ? 1 : -1;
+      int16_t err = dx - dy;
+
+      while (true)
+      {
+        setPixel(x0, y0, true);
+
+        if (x0 == x1 && y0 == y1)
+          break;
+
+        int16_t e2 = 2 * err;
+        if (e2 > -dy)
+        {
+          err -= dy;
+          x0 += sx;
+        }
+        if (e2 < dx)
+        {
+          err += dx;
+          y0 += sy;
+        }
+      }
+    }
+
+    /**
+     * @brief Draws a rectangle.
+     */
+    void drawRectangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+    {
+      drawLine(x0, y0, x1, y0);
+      drawLine(x0, y0, x0, y1);
+      drawLine(x1, y0, x1, y1);
+      drawLine(x0, y1, x1, y1);
+    }
+
+    /**
+     * @brief Draws a circle.
+     */
+    void drawCircle(uint8_t x0, uint8_t y0, uint8_t radius)
+    {
+      int16_t x = radius;
+      int16_t y = 0;
+      int16_t err = 0;
+
+      while (x >= y)
+      {
+        setPixel(x0 + x, y0 + y, true);
+        setPixel(x0 + y, y0 + x, true);
+        setPixel(x0 - y, y0 + x, true);
+        setPixel(x0 - x, y0 + y, true);
+        setPixel(x0 - x, y0 - y, true);
+        setPixel(x0 - y, y0 - x, true);
+        setPixel(x0 + y, y0 - x, true);
+        setPixel(x0 + x, y0 - y, true);
+
+        if (err <= 0)
+        {
+          y += 1;
+          err += 2 * y + 1;
+        }
+        else
+        {
+          x -= 1;
+          err -= 2 * x + 1;
+        }
+      }
+    }
+
+    Buffer &buffer() { return buffer_; }
+    const Buffer &buffer() const { return buffer_; }
+    Bus &bus() { return bus_; }
+
+  private:
+    Bus bus_;
+    Buffer buffer_{};
+    bool invertText_ = false;
+  };
+}
+
+#endif
@@ -0,0 +1,225 @@
+/*
+ * File: dwm_pico_5110_LCD_canvas.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#include <string.h>
+
+#include "dwm_pico_5110_LCD_canvas.h"
+
+extern struct LCD_att lcd;
+
+/**
+ * @brief Initialize a canvas.
+ *
+ * @param canvas  canvas to initialize.
+ * @param buffer  canvas memory, at least LCD_CANVAS_SIZE(width, height) bytes.
+ * @param width   canvas width in pixels.
+ * @param height  canvas height in pixels.
+ */
+void LCD_canvasInit(struct LCD_canvas *canvas, uint8_t *buffer, uint16_t width, uint16_t height)
+{
+  canvas->buffer = buffer;
+  canvas->width = width;
+  canvas->height = height;
+  canvas->rows = (height + LCD_COLUMN_HEIGHT - 1) / LCD_COLUMN_HEIGHT;
+
+  LCD_canvasClear(canvas);
+}
+
+/**
+ * @brief Copy a window of the canvas to lcd.buffer (or current draw target).
+ *        Window starting on a row boundary is copied row by row,
+ *        otherwise every byte is merged from two canvas rows.
+ *        Parts of the window outside the canvas are cleared.
+ *
+ * @param canvas  source canvas.
+ * @param x0      window position on the x-axis.
+ * @param y0      window position on the y-axis.
+ */
+void LCD_canvasBlit(const struct LCD_canvas *canvas, uint16_t x0, uint16_t y0)
+{
+  uint8_t shift = y0 % LCD_COLUMN_HEIGHT;
+  uint16_t width = x0 < canvas->width ? canvas->width - x0 : 0;
+
+  if (width > LCD_WIDTH)
+    width = LCD_WIDTH;
+
+  for (uint8_t row = 0; row < LCD_ROW_NUMBER; row++)
+  {
+    uint16_t bank = y0 / LCD_COLUMN_HEIGHT + row;
+    uint8_t *dst = &lcd.target[row * LCD_WIDTH];
+    const uint8_t *upper = bank < canvas->rows ? &canvas->buffer[bank * canvas->width + x0] : NULL;
+    const uint8_t *lower = bank + 1 < canvas->rows ? &canvas->buffer[(bank + 1) * canvas->width + x0] : NULL;
+
+    memset(&dst[width], 0, LCD_WIDTH - width);
+
+    if (!upper)
+      memset(dst, 0, width);
+    else if (!shift)
+      memcpy(dst, upper, width);
+    else if (!lower)
+      for (uint8_t i = 0; i < width; i++)
+        dst[i] = upper[i] >> shift;
+    else
+      for (uint8_t i = 0; i < width; i++)
+        dst[i] = upper[i] >> shift | lower[i] << (LCD_COLUMN_HEIGHT - shift);
+  }
+
+  lcd.targetDirty = (1 << LCD_ROW_NUMBER) - 1;
+}
+
+/**
+ * @brief Show a window of the canvas on the screen.
+ *
+ * @param canvas  source canvas.
+ * @param x0      window position on the x-axis.
+ * @param y0      window position on the y-axis.
+ */
+void LCD_canvasView(const struct LCD_canvas *canvas, uint16_t x0, uint16_t y0)
+{
+  LCD_canvasBlit(canvas, x0, y0);
+
+  // Drawn in a layer, composing sends it
+  if (lcd.target == lcd.buffer)
+    LCD_refreshScr();
+}
+
+/**
+ * @brief Clears the canvas.
+ *
+ * @param canvas canvas to clear.
+ */
+void LCD_canvasClear(struct LCD_canvas *canvas)
+{
+  memset(canvas->buffer, 0, canvas->width * canvas->rows);
+}
+
+/**
+ * @brief Sets a pixel on the canvas. Pixels outside the canvas are ignored.
+ *
+ * @param canvas  target canvas.
+ * @param x0      pixel location on x axis.
+ * @param y0      pixel location on y axis.
+ * @param mode    true = lit pixel / false = dim pixel.
+ */
+void LCD_canvasSetPixel(struct LCD_canvas *canvas, int16_t x0, int16_t y0, bool mode)
+{
+  if (x0 < 0 || y0 < 0 || x0 >= canvas->width || y0 >= canvas->height)
+    return;
+
+  if (mode)
+    canvas->buffer[x0 + (y0 / LCD_COLUMN_HEIGHT) * canvas->width] |= 1 << (y0 % LCD_COLUMN_HEIGHT);
+  else
+    canvas->buffer[x0 + (y0 / LCD_COLUMN_HEIGHT) * canvas->width] &= ~(1 << (y0 % LCD_COLUMN_HEIGHT));
+}
+
+/**
+ * @brief Get pixel state on the canvas.
+ *
+ * @param canvas  source canvas.
+ * @param x0      pixel location on x axis.
+ * @param y0      pixel location on y axis.
+ * @return        true = pixel is lit / false = pixel is dimmed or outside the canvas.
+ */
+bool LCD_canvasGetPixel(const struct LCD_canvas *canvas, int16_t x0, int16_t y0)
+{
+  if (x0 < 0 || y0 < 0 || x0 >= canvas->width || y0 >= canvas->height)
+    return false;
+
+  return canvas->buffer[x0 + (y0 / LCD_COLUMN_HEIGHT) * canvas->width] >> (y0 % LCD_COLUMN_HEIGHT) & 1;
+}
+
+/**
+ * @brief Draw a run of a line on the canvas, LCD_lineRuns() callback.
+ */
+static void LCD_canvasLineRun(void *context, int16_t x0, int16_t y0, uint32_t length, bool horizontal, int8_t step)
+{
+  int16_t *position = horizontal ? &x0 : &y0;
+
+  for (uint32_t i = 0; i < length; i++, *position += step)
+    LCD_canvasSetPixel(context, x0, y0, true);
+}
+
+/**
+ * @brief Draws any line on the canvas, based on Bresenham's line algorithm (LCD_lineRuns()).
+ *
+ * @param canvas  target canvas.
+ * @param x0      starting point on the x-axis.
+ * @param y0      starting point on the y-axis.
+ * @param x1      ending point on the x-axis.
+ * @param y1      ending point on the y-axis.
+ */
+void LCD_canvasDrawLine(struct LCD_canvas *canvas, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+  LCD_lineRuns(x0, y0, x1, y1, LCD_canvasLineRun, canvas);
+}
+
+/**
+ * @brief Draws a rectangle on the canvas.
+ *
+ * @param canvas  target canvas.
+ * @param x0      starting point on the x-axis.
+ * @param y0      starting point on the y-axis.
+ * @param x1      ending point on the x-axis.
+ * @param y1      ending point on the y-axis.
+ */
+void LCD_canvasDrawRectangle(struct LCD_canvas *canvas, int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+  LCD_canvasDrawLine(canvas, x0, y0, x1, y0);
+  LCD_canvasDrawLine(canvas, x0, y0, x0, y1);
+  LCD_canvasDrawLine(canvas, x1, y0, x1, y1);
+  LCD_canvasDrawLine(canvas, x0, y1, x1, y1);
+}
+
+/**
+ * @brief Draws one char on the canvas. Chars starting on a row boundary are copied,
+ *        others are split over two rows.
+ *
+ * @param canvas  target canvas.
+ * @param c       char to be drawn.
+ * @param x0      top left corner on the x-axis.
+ * @param y0      top left corner on the y-axis.
+ */
+void LCD_canvasPutChar(struct LCD_canvas *canvas, char c, int16_t x0, int16_t y0)
+{
+  if (y0 % LCD_COLUMN_HEIGHT || y0 < 0 || x0 < 0 || x0 + FONT_SYMBOL_WIDTH > canvas->width || y0 >= canvas->height)
+  {
+    for (uint8_t i = 0; i < FONT_SYMBOL_WIDTH; i++)
+    {
+      uint8_t column = lcd.invertText ? ~ASCII[c - 0x20][i] : ASCII[c - 0x20][i];
+
+      for (uint8_t j = 0; j < LCD_COLUMN_HEIGHT; j++)
+        LCD_canvasSetPixel(canvas, x0 + i, y0 + j, column >> j & 1);
+    }
+    return;
+  }
+
+  uint8_t *dst = &canvas->buffer[(y0 / LCD_COLUMN_HEIGHT) * canvas->width + x0];
+
+  for (uint8_t i = 0; i < FONT_SYMBOL_WIDTH; i++)
+    dst[i] = lcd.invertText ? ~ASCII[c - 0x20][i] : ASCII[c - 0x20][i];
+}
+
+/**
+ * @brief Draws a string on the canvas.
+ *
+ * @param canvas  target canvas.
+ * @param str     string to draw.
+ * @param x0      top left corner on the x-axis.
+ * @param y0      top left corner on the y-axis.
+ */
+void LCD_canvasPrint(struct LCD_canvas *canvas, char *str, int16_t x0, int16_t y0)
+{
+  while (*str)
+  {
+    LCD_canvasPutChar(canvas, *str++, x0, y0);
+    x0 += FONT_SYMBOL_WIDTH;
+  }
+}
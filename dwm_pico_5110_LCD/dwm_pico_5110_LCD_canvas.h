@@ -0,0 +1,53 @@
+/*
+ * File: dwm_pico_5110_LCD_canvas.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#ifndef DWM_PICO_5110_LCD_CANVAS
+#define DWM_PICO_5110_LCD_CANVAS
+
+#include "dwm_pico_5110_LCD.h"
+
+/*
+ * Off-screen canvas of any size, in lcd.buffer layout (rows of 8 lines, one byte per column).
+ * A window of the canvas is copied to lcd.buffer with LCD_canvasBlit(), so scrolling
+ * costs one copy instead of redrawing the content.
+ */
+
+// Number of bytes needed by canvas of given size
+#define LCD_CANVAS_SIZE(width, height) ((width) * (((height) + LCD_COLUMN_HEIGHT - 1) / LCD_COLUMN_HEIGHT))
+
+/**
+ * @brief Canvas parameters.
+ */
+struct LCD_canvas
+{
+	uint8_t *buffer;
+	uint16_t width;
+	uint16_t height;
+	uint16_t rows;
+};
+
+/*----- Library Functions -----*/
+
+void LCD_canvasInit(struct LCD_canvas *canvas, uint8_t *buffer, uint16_t width, uint16_t height);
+void LCD_canvasBlit(const struct LCD_canvas *canvas, uint16_t x0, uint16_t y0);
+void LCD_canvasView(const struct LCD_canvas *canvas, uint16_t x0, uint16_t y0);
+
+/*----- Draw Functions -----*/
+
+void LCD_canvasClear(struct LCD_canvas *canvas);
+void LCD_canvasSetPixel(struct LCD_canvas *canvas, int16_t x0, int16_t y0, bool mode);
+bool LCD_canvasGetPixel(const struct LCD_canvas *canvas, int16_t x0, int16_t y0);
+void LCD_canvasDrawLine(struct LCD_canvas *canvas, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+void LCD_canvasDrawRectangle(struct LCD_canvas *canvas, int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+void LCD_canvasPutChar(struct LCD_canvas *canvas, char c, int16_t x0, int16_t y0);
+void LCD_canvasPrint(struct LCD_canvas *canvas, char *str, int16_t x0, int16_t y0);
+
+#endif
@@ -0,0 +1,117 @@
+/*
+ * File: dwm_pico_5110_LCD_capture.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "pico/stdlib.h"
+
+#include "dwm_pico_5110_LCD_capture.h"
+
+extern struct LCD_att lcd;
+
+/**
+ * @brief Convert a frame in LCD's layout into PBM rows.
+ *
+ * @param frame   frame in LCD's layout.
+ * @param rows    output, LCD_ROW_FRAME_SIZE bytes.
+ * @param display display control command the pixels are shown with.
+ */
+static void LCD_captureToRows(const uint8_t *frame, uint8_t *rows, uint8_t display)
+{
+  uint8_t columns[LCD_COLUMN_HEIGHT];
+  uint8_t fill = display == LCD_DISPLAY_ALL_ON ? 0xFF : 0x00;
+
+  if (display == LCD_DISPLAY_BLANK || display == LCD_DISPLAY_ALL_ON)
+  {
+    memset(rows, fill, LCD_ROW_FRAME_SIZE);
+    return;
+  }
+
+  for (uint8_t row = 0; row < LCD_ROW_NUMBER; row++)
+    for (uint8_t i = 0; i < LCD_ROW_BYTES; i++)
+    {
+      uint8_t width = LCD_WIDTH - i * 8 < 8 ? LCD_WIDTH - i * 8 : 8;
+
+      // Columns go in reverse order, so the leftmost pixel lands in the most significant bit
+      memset(columns, 0, sizeof(columns));
+      for (uint8_t j = 0; j < width; j++)
+        columns[7 - j] = frame[row * LCD_WIDTH + i * 8 + j];
+
+      LCD_transpose8(columns, 1, &rows[row * LCD_COLUMN_HEIGHT * LCD_ROW_BYTES + i], LCD_ROW_BYTES);
+    }
+
+  if (display == LCD_DISPLAY_INVERTED)
+    for (uint16_t i = 0; i < LCD_ROW_FRAME_SIZE; i++)
+      rows[i] = ~rows[i] & (i % LCD_ROW_BYTES == LCD_ROW_BYTES - 1 ? (uint8_t)(0xFF << (LCD_ROW_BYTES * 8 - LCD_WIDTH)) : 0xFF);
+}
+
+/**
+ * @brief Serialise a frame.
+ *
+ * @param source  lcd.buffer or shadow of the panel.
+ * @param format  PBM or binary frame.
+ * @param costUs  rendering cost stored with the frame, 0 if unknown.
+ * @param out     output, at least LCD_CAPTURE_MAX_SIZE bytes.
+ *
+ * @return number of bytes written to out.
+ */
+uint16_t LCD_captureFrame(enum LCD_captureSource source, enum LCD_captureFormat format, uint32_t costUs, uint8_t *out)
+{
+  const struct LCD_shadow *shadow = LCD_getShadow();
+  const uint8_t *frame = source == LCD_CAPTURE_PANEL ? shadow->ram : lcd.target;
+  uint8_t display = source == LCD_CAPTURE_PANEL ? shadow->display : LCD_DISPLAY_NORMAL;
+  uint16_t size;
+
+  if (format == LCD_CAPTURE_PBM)
+  {
+    size = snprintf((char *)out, LCD_CAPTURE_PBM_HEADER_MAX, "P4\n# cost_us %lu\n%u %u\n",
+                    (unsigned long)costUs, LCD_WIDTH, LCD_HEIGHT);
+    LCD_captureToRows(frame, &out[size], display);
+
+    return size + LCD_ROW_FRAME_SIZE;
+  }
+
+  memcpy(out, LCD_CAPTURE_MAGIC, 4);
+  out[4] = LCD_WIDTH;
+  out[5] = LCD_HEIGHT;
+  out[6] = source == LCD_CAPTURE_PANEL ? LCD_CAPTURE_FLAG_PANEL : 0;
+  out[7] = 0;
+  for (uint8_t i = 0; i < 4; i++)
+    out[8 + i] = costUs >> (i * 8);
+
+  if (display == LCD_DISPLAY_INVERTED)
+    out[6] |= LCD_CAPTURE_FLAG_INVERTED;
+
+  // Blank and all-on display ignore the RAM, so the frame is stored as it's shown
+  if (display == LCD_DISPLAY_BLANK || display == LCD_DISPLAY_ALL_ON)
+    memset(&out[LCD_CAPTURE_HEADER_SIZE], display == LCD_DISPLAY_ALL_ON ? 0xFF : 0x00, LCD_SIZE);
+  else
+    memcpy(&out[LCD_CAPTURE_HEADER_SIZE], frame, LCD_SIZE);
+
+  return LCD_CAPTURE_HEADER_SIZE + LCD_SIZE;
+}
+
+/**
+ * @brief Serialise a frame and write it on stdio, without CR/LF translation.
+ *
+ * @param source  lcd.buffer or shadow of the panel.
+ * @param format  PBM or binary frame.
+ * @param costUs  rendering cost stored with the frame, 0 if unknown.
+ */
+void LCD_captureStream(enum LCD_captureSource source, enum LCD_captureFormat format, uint32_t costUs)
+{
+  static uint8_t capture[LCD_CAPTURE_MAX_SIZE];
+  uint16_t size = LCD_captureFrame(source, format, costUs, capture);
+
+  for (uint16_t i = 0; i < size; i++)
+    putchar_raw(capture[i]);
+}
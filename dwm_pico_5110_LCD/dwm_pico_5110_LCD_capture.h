@@ -0,0 +1,58 @@
+/*
+ * File: dwm_pico_5110_LCD_capture.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#ifndef DWM_PICO_5110_LCD_CAPTURE
+#define DWM_PICO_5110_LCD_CAPTURE
+
+#include "dwm_pico_5110_LCD.h"
+#include "dwm_pico_5110_LCD_rowmajor.h"
+
+/*
+ * Frame capture. A frame is serialised either as binary PBM (P4), which any image
+ * viewer opens, or as a compact binary frame in LCD's own vertical byte layout:
+ *
+ *   "LCDF" width height flags 0 cost_us(uint32, little endian) data[width * height / 8]
+ *
+ * Rendering cost passed by the caller is kept with the frame (PBM comment "# cost_us N"),
+ * tools/capture_compare.py compares captured frames against golden images.
+ */
+
+#define LCD_CAPTURE_MAGIC "LCDF"
+#define LCD_CAPTURE_HEADER_SIZE 12
+#define LCD_CAPTURE_PBM_HEADER_MAX 40
+#define LCD_CAPTURE_MAX_SIZE (LCD_CAPTURE_PBM_HEADER_MAX + LCD_ROW_FRAME_SIZE)
+
+// Binary frame flags
+#define LCD_CAPTURE_FLAG_PANEL 0x01
+#define LCD_CAPTURE_FLAG_INVERTED 0x02
+
+/**
+ * @brief What is captured.
+ */
+enum LCD_captureSource
+{
+	LCD_CAPTURE_BUFFER, // lcd.buffer (or current draw target), picture before rotation and mirroring
+	LCD_CAPTURE_PANEL	// what the panel shows, needs LCD_ENABLE_SHADOW
+};
+
+/**
+ * @brief Capture format.
+ */
+enum LCD_captureFormat
+{
+	LCD_CAPTURE_PBM,
+	LCD_CAPTURE_BINARY
+};
+
+uint16_t LCD_captureFrame(enum LCD_captureSource source, enum LCD_captureFormat format, uint32_t costUs, uint8_t *out);
+void LCD_captureStream(enum LCD_captureSource source, enum LCD_captureFormat format, uint32_t costUs);
+
+#endif
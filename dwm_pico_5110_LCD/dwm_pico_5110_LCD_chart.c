@@ -0,0 +1,297 @@
+/*
+ * File: dwm_pico_5110_LCD_chart.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#include <string.h>
+
+#include "dwm_pico_5110_LCD_chart.h"
+
+extern struct LCD_att lcd;
+
+/**
+ * @brief Initialize a chart and clear its plot area.
+ *        Chart uses fixed scale of -32768 - 32767 until LCD_chartSetScale() or LCD_chartSetAutoscale().
+ *
+ * @param chart   chart to initialize.
+ * @param samples sample memory, width entries.
+ * @param x0      plot area position on the x-axis.
+ * @param width   plot area width (one sample per column).
+ * @param row     first row of the plot area (multiple of 8 lines).
+ * @param nRow    number of rows of the plot area.
+ * @param style   line or bar.
+ * @param mode    sweep or scroll.
+ */
+void LCD_chartInit(struct LCD_chart *chart, int16_t *samples, uint8_t x0, uint8_t width, uint8_t row, uint8_t nRow,
+                   enum LCD_chartStyle style, enum LCD_chartMode mode)
+{
+  if (x0 + width > LCD_WIDTH)
+    width = x0 < LCD_WIDTH ? LCD_WIDTH - x0 : 0;
+  if (row + nRow > LCD_ROW_NUMBER)
+    nRow = row < LCD_ROW_NUMBER ? LCD_ROW_NUMBER - row : 0;
+
+  chart->samples = samples;
+  chart->x0 = x0;
+  chart->width = width;
+  chart->row = row;
+  chart->nRow = nRow;
+  chart->style = style;
+  chart->mode = mode;
+  chart->autoscale = false;
+  chart->min = INT16_MIN;
+  chart->max = INT16_MAX;
+
+  LCD_chartClear(chart);
+}
+
+/**
+ * @brief Set scale, an empty range is widened to one step.
+ *
+ * @param chart chart.
+ * @param min   value at the bottom of the plot area.
+ * @param max   value at the top of the plot area.
+ */
+static void LCD_chartSetRange(struct LCD_chart *chart, int16_t min, int16_t max)
+{
+  // INT16_MAX can't be widened upwards, range goes one step down instead
+  if (max <= min)
+  {
+    if (min == INT16_MAX)
+      min--;
+    max = min + 1;
+  }
+
+  chart->min = min;
+  chart->max = max;
+}
+
+/**
+ * @brief Fit scale to the samples.
+ *
+ * @param chart chart.
+ * @return      true = scale changed.
+ */
+static bool LCD_chartFit(struct LCD_chart *chart)
+{
+  int16_t min = INT16_MAX;
+  int16_t max = INT16_MIN;
+  int16_t oldMin = chart->min;
+  int16_t oldMax = chart->max;
+
+  for (uint8_t i = 0; i < chart->count; i++)
+  {
+    if (chart->samples[i] < min)
+      min = chart->samples[i];
+    if (chart->samples[i] > max)
+      max = chart->samples[i];
+  }
+
+  LCD_chartSetRange(chart, min, max);
+
+  return chart->min != oldMin || chart->max != oldMax;
+}
+
+/**
+ * @brief Use fixed scale, redraws the chart.
+ *
+ * @param chart chart.
+ * @param min   value at the bottom of the plot area.
+ * @param max   value at the top of the plot area.
+ */
+void LCD_chartSetScale(struct LCD_chart *chart, int16_t min, int16_t max)
+{
+  chart->autoscale = false;
+  LCD_chartSetRange(chart, min, max);
+
+  LCD_chartRedraw(chart);
+}
+
+/**
+ * @brief Fit scale to the samples shown. Scale grows when a sample does not fit
+ *        and shrinks when the extreme sample leaves the chart.
+ *
+ * @param chart chart.
+ */
+void LCD_chartSetAutoscale(struct LCD_chart *chart)
+{
+  chart->autoscale = true;
+  LCD_chartFit(chart);
+
+  LCD_chartRedraw(chart);
+}
+
+/**
+ * @brief Convert a sample into a line of the plot area.
+ *
+ * @param chart chart.
+ * @param value sample.
+ * @return      line, 0 is the top of the plot area.
+ */
+static uint8_t LCD_chartY(const struct LCD_chart *chart, int16_t value)
+{
+  int32_t bottom = chart->nRow * LCD_COLUMN_HEIGHT - 1;
+
+  if (value <= chart->min)
+    return bottom;
+  if (value >= chart->max)
+    return 0;
+
+  return bottom - ((int32_t)value - chart->min) * bottom / ((int32_t)chart->max - chart->min);
+}
+
+/**
+ * @brief Render one column of the plot area into lcd.buffer.
+ *
+ * @param chart     chart.
+ * @param column    column of the plot area.
+ * @param value     sample shown in the column.
+ * @param previous  pointer to the sample before, NULL if there is none.
+ */
+static void LCD_chartRenderColumn(const struct LCD_chart *chart, uint8_t column, const int16_t *value, const int16_t *previous)
+{
+  uint64_t mask = 0;
+
+  // Column is built as one mask covering all rows of the plot area
+  if (value)
+  {
+    uint8_t y0 = LCD_chartY(chart, *value);
+    uint8_t y1 = y0;
+
+    if (chart->style == LCD_CHART_BAR)
+      y1 = chart->nRow * LCD_COLUMN_HEIGHT - 1;
+    else if (previous)
+      y1 = LCD_chartY(chart, *previous);
+
+    if (y0 > y1)
+    {
+      uint8_t tmp = y0;
+      y0 = y1;
+      y1 = tmp;
+    }
+
+    mask = (UINT64_MAX >> (63 - y1)) & (UINT64_MAX << y0);
+  }
+
+  for (uint8_t i = 0; i < chart->nRow; i++)
+  {
+    lcd.target[(chart->row + i) * LCD_WIDTH + chart->x0 + column] = mask >> (i * LCD_COLUMN_HEIGHT);
+    lcd.targetDirty |= 1 << (chart->row + i);
+  }
+}
+
+/**
+ * @brief Render the sample shown in a column of the plot area.
+ *
+ * @param chart   chart.
+ * @param column  column of the plot area.
+ */
+static void LCD_chartRender(const struct LCD_chart *chart, uint8_t column)
+{
+  if (chart->mode == LCD_CHART_SWEEP)
+  {
+    // Column shows the sample with the same index, cursor column stays empty
+    bool shown = column < chart->count && (column != chart->head || chart->count < chart->width);
+
+    LCD_chartRenderColumn(chart, column, shown ? &chart->samples[column] : NULL,
+                          shown && column ? &chart->samples[column - 1] : NULL);
+    return;
+  }
+
+  // Oldest sample on the left, newest on the right
+  int16_t age = chart->width - 1 - column;
+  uint8_t index = (chart->head + chart->width - 1 - age) % chart->width;
+  uint8_t before = (index + chart->width - 1) % chart->width;
+
+  LCD_chartRenderColumn(chart, column, age < chart->count ? &chart->samples[index] : NULL,
+                        age + 1 < chart->count ? &chart->samples[before] : NULL);
+}
+
+/**
+ * @brief Add a sample, only changed columns are rendered and sent.
+ *        With autoscale, a change of the scale redraws the whole chart.
+ *
+ * @param chart chart.
+ * @param value sample.
+ */
+void LCD_chartAdd(struct LCD_chart *chart, int16_t value)
+{
+  if (!chart->width || !chart->nRow)
+    return;
+
+  // Sample pushed out of a full chart may have set the scale
+  int16_t dropped = chart->samples[chart->head];
+  bool extreme = chart->count == chart->width && (dropped <= chart->min || dropped >= chart->max);
+
+  chart->samples[chart->head] = value;
+  chart->head = (chart->head + 1) % chart->width;
+  if (chart->count < chart->width)
+    chart->count++;
+
+  if (chart->autoscale && (extreme || value < chart->min || value > chart->max) && LCD_chartFit(chart))
+  {
+    LCD_chartRedraw(chart);
+    return;
+  }
+
+  if (chart->mode == LCD_CHART_SWEEP)
+  {
+    uint8_t column = (chart->head + chart->width - 1) % chart->width;
+
+    LCD_chartRender(chart, column);
+    LCD_chartRender(chart, chart->head);
+
+    // Drawn in a layer, composing sends it
+    if (lcd.target == lcd.buffer)
+    {
+      LCD_refreshColumn(chart->x0 + column, chart->row, chart->nRow);
+      LCD_refreshColumn(chart->x0 + chart->head, chart->row, chart->nRow);
+    }
+    return;
+  }
+
+  for (uint8_t i = 0; i < chart->nRow; i++)
+  {
+    uint8_t *line = &lcd.target[(chart->row + i) * LCD_WIDTH + chart->x0];
+    memmove(line, line + 1, chart->width - 1);
+  }
+
+  // Leftmost column lost the sample it was connected to
+  LCD_chartRender(chart, 0);
+  LCD_chartRender(chart, chart->width - 1);
+
+  if (lcd.target == lcd.buffer)
+    LCD_refreshArea(chart->x0, chart->x0 + chart->width, chart->row, chart->nRow);
+}
+
+/**
+ * @brief Remove all samples and clear the plot area.
+ *
+ * @param chart chart.
+ */
+void LCD_chartClear(struct LCD_chart *chart)
+{
+  chart->head = 0;
+  chart->count = 0;
+
+  LCD_chartRedraw(chart);
+}
+
+/**
+ * @brief Render and send the whole plot area.
+ *
+ * @param chart chart.
+ */
+void LCD_chartRedraw(struct LCD_chart *chart)
+{
+  for (uint8_t column = 0; column < chart->width; column++)
+    LCD_chartRender(chart, column);
+
+  if (lcd.target == lcd.buffer)
+    LCD_refreshArea(chart->x0, chart->x0 + chart->width, chart->row, chart->nRow);
+}
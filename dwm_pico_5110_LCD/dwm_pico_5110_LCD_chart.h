@@ -0,0 +1,77 @@
+/*
+ * File: dwm_pico_5110_LCD_chart.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#ifndef DWM_PICO_5110_LCD_CHART
+#define DWM_PICO_5110_LCD_CHART
+
+#include "dwm_pico_5110_LCD.h"
+
+/*
+ * Strip chart of a live signal. Plot area spans whole rows (multiple of 8 lines),
+ * so a column of the plot is whole bytes of lcd.buffer.
+ *
+ * LCD_CHART_SWEEP - new samples are written at a moving cursor, like an oscilloscope,
+ *                   adding a sample renders and sends 2 columns.
+ * LCD_CHART_SCROLL - plot moves left by one column per sample, newest on the right,
+ *                    adding a sample shifts the plot in lcd.buffer and sends the plot area.
+ *
+ * Autoscale fits the samples shown, it widens on a sample out of scale and narrows
+ * again once the extreme sample leaves the chart (both redraw the whole plot area).
+ */
+
+/**
+ * @brief How samples are drawn.
+ */
+enum LCD_chartStyle
+{
+	LCD_CHART_LINE,
+	LCD_CHART_BAR
+};
+
+/**
+ * @brief How the plot advances.
+ */
+enum LCD_chartMode
+{
+	LCD_CHART_SWEEP,
+	LCD_CHART_SCROLL
+};
+
+/**
+ * @brief Chart parameters.
+ */
+struct LCD_chart
+{
+	int16_t *samples;
+	uint8_t x0;
+	uint8_t width;
+	uint8_t row;
+	uint8_t nRow;
+	enum LCD_chartStyle style;
+	enum LCD_chartMode mode;
+	bool autoscale;
+	int16_t min;
+	int16_t max;
+	uint8_t head;
+	uint8_t count;
+};
+
+/*----- Library Functions -----*/
+
+void LCD_chartInit(struct LCD_chart *chart, int16_t *samples, uint8_t x0, uint8_t width, uint8_t row, uint8_t nRow,
+                   enum LCD_chartStyle style, enum LCD_chartMode mode);
+void LCD_chartSetScale(struct LCD_chart *chart, int16_t min, int16_t max);
+void LCD_chartSetAutoscale(struct LCD_chart *chart);
+void LCD_chartAdd(struct LCD_chart *chart, int16_t value);
+void LCD_chartClear(struct LCD_chart *chart);
+void LCD_chartRedraw(struct LCD_chart *chart);
+
+#endif
@@ -0,0 +1,231 @@
+/*
+ * File: dwm_pico_5110_LCD_layers.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#include <string.h>
+
+#include "dwm_pico_5110_LCD_layers.h"
+
+// Words in one row, LCD_WIDTH is a multiple of 4
+#define LCD_ROW_WORDS (LCD_WIDTH / 4)
+
+#define LCD_ALL_ROWS ((1 << LCD_ROW_NUMBER) - 1)
+
+// Word of a frame, frames are uint8_t arrays so word access has to be allowed to alias them
+typedef uint32_t __attribute__((may_alias)) LCD_word;
+
+struct LCD_layerStack lcd_layers;
+
+extern struct LCD_att lcd;
+
+// Layer being drawn in
+static struct LCD_layer *active;
+
+// Rows uncovered by a removed layer
+static uint8_t removed;
+
+/**
+ * @brief Put a cleared, visible layer on top of the stack.
+ *
+ * @param layer layer, must stay valid while in the stack.
+ * @param op    how it's combined with the layers below.
+ *
+ * @return false if the stack is full.
+ */
+bool LCD_layerAdd(struct LCD_layer *layer, enum LCD_layerOp op)
+{
+  if (lcd_layers.count >= LCD_LAYER_MAX)
+    return false;
+
+  memset(layer->buffer, 0, LCD_SIZE);
+  layer->op = op;
+  layer->visible = true;
+  layer->dirty = LCD_ALL_ROWS;
+
+  lcd_layers.layers[lcd_layers.count++] = layer;
+
+  return true;
+}
+
+/**
+ * @brief Take a layer out of the stack, rows it covered are composed on next refresh.
+ *        The layer's buffer may be reused or freed afterwards.
+ *
+ * @param layer layer.
+ *
+ * @return false if the layer isn't in the stack.
+ */
+bool LCD_layerRemove(struct LCD_layer *layer)
+{
+  uint8_t i = 0;
+
+  while (i < lcd_layers.count && lcd_layers.layers[i] != layer)
+    i++;
+
+  if (i == lcd_layers.count)
+    return false;
+
+  if (active == layer)
+    LCD_layerEnd();
+
+  for (lcd_layers.count--; i < lcd_layers.count; i++)
+    lcd_layers.layers[i] = lcd_layers.layers[i + 1];
+
+  removed = LCD_ALL_ROWS;
+
+  return true;
+}
+
+/**
+ * @brief Redirect draw functions (LCD_setPixel(), LCD_drawLine(), LCD_clrBuff()...) to a layer.
+ *
+ * @param layer layer to draw in.
+ */
+void LCD_layerBegin(struct LCD_layer *layer)
+{
+  if (active)
+    LCD_layerEnd();
+
+  active = layer;
+  lcd.targetDirty = 0;
+  LCD_setDrawTarget(layer->buffer);
+}
+
+/**
+ * @brief Stop drawing in a layer, rows drawn in are composed on next refresh.
+ */
+void LCD_layerEnd()
+{
+  if (!active)
+    return;
+
+  active->dirty |= lcd.targetDirty;
+  active = NULL;
+  LCD_setDrawTarget(NULL);
+}
+
+/**
+ * @brief Mark rows of a layer as changed, needed after writing in layer's buffer directly.
+ *
+ * @param layer layer.
+ * @param row   starting row (multiple of 8 lines).
+ * @param nRow  number of rows.
+ */
+void LCD_layerInvalidate(struct LCD_layer *layer, uint8_t row, uint8_t nRow)
+{
+  for (uint8_t i = row; i < row + nRow && i < LCD_ROW_NUMBER; i++)
+    layer->dirty |= 1 << i;
+}
+
+/**
+ * @brief Show or hide a layer.
+ *
+ * @param layer   layer.
+ * @param visible true = composed / false = skipped.
+ */
+void LCD_layerSetVisible(struct LCD_layer *layer, bool visible)
+{
+  if (layer->visible != visible)
+    layer->dirty = LCD_ALL_ROWS;
+
+  layer->visible = visible;
+}
+
+/**
+ * @brief Change how a layer is combined with the layers below.
+ *
+ * @param layer layer.
+ * @param op    or / and-not / xor.
+ */
+void LCD_layerSetOp(struct LCD_layer *layer, enum LCD_layerOp op)
+{
+  if (layer->op != op)
+    layer->dirty = LCD_ALL_ROWS;
+
+  layer->op = op;
+}
+
+/**
+ * @brief Compose one row of all visible layers into lcd.buffer, a word (4 columns) at a time.
+ *        Frames are word aligned and rows start at multiples of LCD_WIDTH, so are rows.
+ *
+ * @param row row number.
+ */
+static void LCD_layersComposeRow(uint8_t row)
+{
+  LCD_word *dst = (LCD_word *)&lcd.buffer[row * LCD_WIDTH];
+
+  memset(dst, 0, LCD_WIDTH);
+
+  for (uint8_t i = 0; i < lcd_layers.count; i++)
+  {
+    const struct LCD_layer *layer = lcd_layers.layers[i];
+    const LCD_word *src = (const LCD_word *)&layer->buffer[row * LCD_WIDTH];
+
+    if (!layer->visible)
+      continue;
+
+    if (layer->op == LCD_LAYER_OR)
+      for (uint8_t j = 0; j < LCD_ROW_WORDS; j++)
+        dst[j] |= src[j];
+    else if (layer->op == LCD_LAYER_AND_NOT)
+      for (uint8_t j = 0; j < LCD_ROW_WORDS; j++)
+        dst[j] &= ~src[j];
+    else
+      for (uint8_t j = 0; j < LCD_ROW_WORDS; j++)
+        dst[j] ^= src[j];
+  }
+}
+
+/**
+ * @brief Compose rows changed in any layer into lcd.buffer.
+ *
+ * @return changed rows, bit n = row n.
+ */
+uint8_t LCD_layersCompose()
+{
+  uint8_t dirty = removed;
+
+  LCD_layerEnd();
+  removed = 0;
+
+  for (uint8_t i = 0; i < lcd_layers.count; i++)
+  {
+    dirty |= lcd_layers.layers[i]->dirty;
+    lcd_layers.layers[i]->dirty = 0;
+  }
+
+  for (uint8_t row = 0; row < LCD_ROW_NUMBER; row++)
+    if (dirty & 1 << row)
+      LCD_layersComposeRow(row);
+
+  return dirty;
+}
+
+/**
+ * @brief Compose changed rows and send them to the LCD, adjacent rows in one transfer.
+ */
+void LCD_layersRefresh()
+{
+  uint8_t dirty = LCD_layersCompose();
+
+  for (uint8_t row = 0; row < LCD_ROW_NUMBER;)
+  {
+    uint8_t nRow = 0;
+
+    while (row + nRow < LCD_ROW_NUMBER && dirty & 1 << (row + nRow))
+      nRow++;
+
+    if (nRow)
+      LCD_refreshArea(0, LCD_WIDTH, row, nRow);
+
+    row += nRow ? nRow : 1;
+  }
+}
@@ -0,0 +1,76 @@
+/*
+ * File: dwm_pico_5110_LCD_layers.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#ifndef DWM_PICO_5110_LCD_LAYERS
+#define DWM_PICO_5110_LCD_LAYERS
+
+#include "dwm_pico_5110_LCD.h"
+
+/*
+ * Layered compositing. Every layer is a full frame in lcd.buffer layout, layers are
+ * composed bottom to top into lcd.buffer when the screen is refreshed. Only rows
+ * changed in any layer since the last refresh are composed and sent, so a static
+ * background is drawn once and only the overlay is redrawn.
+ *
+ * Between LCD_layerBegin() and LCD_layerEnd() these draw in the layer: core draw
+ * functions, LCD_vector* / LCD_gauge*, LCD_parallelRender(), LCD_canvasBlit() / LCD_canvasView(),
+ * LCD_rowToBuffer(NULL), LCD_textFlush(), LCD_tilemapRender() and LCD_chart*. Modules that
+ * normally send what they drew leave it to LCD_layersRefresh() instead.
+ * LCD_rowRefreshScr(), LCD_refreshFrame() and the tiled module bypass layers.
+ */
+
+#define LCD_LAYER_MAX 4
+
+/**
+ * @brief How a layer is combined with the layers below it.
+ */
+enum LCD_layerOp
+{
+	LCD_LAYER_OR,	   // lit pixels are drawn
+	LCD_LAYER_AND_NOT, // lit pixels erase the layers below
+	LCD_LAYER_XOR	   // lit pixels invert the layers below
+};
+
+/**
+ * @brief Layer, drawn in with LCD_layerBegin() / LCD_layerEnd() and regular draw functions.
+ */
+struct LCD_layer
+{
+	uint8_t buffer[LCD_SIZE] __attribute__((aligned(4)));
+	enum LCD_layerOp op;
+	bool visible;
+	uint8_t dirty;
+};
+
+/**
+ * @brief Layers in composition order, bottom first.
+ */
+struct LCD_layerStack
+{
+	struct LCD_layer *layers[LCD_LAYER_MAX];
+	uint8_t count;
+};
+
+extern struct LCD_layerStack lcd_layers;
+
+/*----- Layer Functions -----*/
+
+bool LCD_layerAdd(struct LCD_layer *layer, enum LCD_layerOp op);
+bool LCD_layerRemove(struct LCD_layer *layer);
+void LCD_layerBegin(struct LCD_layer *layer);
+void LCD_layerEnd();
+void LCD_layerInvalidate(struct LCD_layer *layer, uint8_t row, uint8_t nRow);
+void LCD_layerSetVisible(struct LCD_layer *layer, bool visible);
+void LCD_layerSetOp(struct LCD_layer *layer, enum LCD_layerOp op);
+uint8_t LCD_layersCompose();
+void LCD_layersRefresh();
+
+#endif
@@ -0,0 +1,357 @@
+/*
+ * File: dwm_pico_5110_LCD_parallel.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "pico/multicore.h"
+
+#include "dwm_pico_5110_LCD_parallel.h"
+
+#ifndef MIN
+#define MIN(a, b) ((a) < (b) ? (a) : (b))
+#endif
+#ifndef MAX
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+#endif
+
+extern struct LCD_att lcd;
+
+// First row drawn by core 1
+static uint8_t split = LCD_ROW_NUMBER / 2;
+static const struct LCD_batch *volatile pending;
+static struct LCD_parallelTimes times;
+
+/**
+ * @brief Append an operation to the batch.
+ *
+ * @return pointer to the operation, NULL if the batch is full.
+ */
+static struct LCD_batchOp *LCD_batchAdd(struct LCD_batch *batch, uint8_t type)
+{
+  struct LCD_batchOp *op;
+
+  if (batch->count >= LCD_BATCH_MAX_OPS)
+    return NULL;
+
+  op = &batch->ops[batch->count++];
+  op->type = type;
+  op->str = NULL;
+
+  return op;
+}
+
+/**
+ * @brief Remove all operations from the batch.
+ *
+ * @param batch batch.
+ */
+void LCD_batchReset(struct LCD_batch *batch)
+{
+  batch->count = 0;
+}
+
+/**
+ * @brief Record clearing of lcd.buffer.
+ *
+ * @param batch batch.
+ */
+bool LCD_batchClrBuff(struct LCD_batch *batch)
+{
+  return LCD_batchAdd(batch, LCD_BATCH_CLEAR);
+}
+
+/**
+ * @brief Record LCD_setPixel().
+ *
+ * @param batch batch.
+ * @param x0    pixel location on x axis.
+ * @param y0    pixel location on y axis.
+ * @param mode  true = lit pixel / false = dim pixel.
+ */
+bool LCD_batchPixel(struct LCD_batch *batch, uint8_t x0, uint8_t y0, bool mode)
+{
+  struct LCD_batchOp *op = LCD_batchAdd(batch, LCD_BATCH_PIXEL);
+
+  if (!op)
+    return false;
+
+  op->arg[0] = x0;
+  op->arg[1] = y0;
+  op->arg[2] = mode;
+
+  return true;
+}
+
+/**
+ * @brief Record LCD_drawLine().
+ *
+ * @param batch batch.
+ * @param x0    starting point on x-axis.
+ * @param y0    starting point on y-axis.
+ * @param x1    ending point on x-axis.
+ * @param y1    ending point on y-axis.
+ */
+bool LCD_batchLine(struct LCD_batch *batch, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+  struct LCD_batchOp *op = LCD_batchAdd(batch, LCD_BATCH_LINE);
+
+  if (!op)
+    return false;
+
+  op->arg[0] = x0;
+  op->arg[1] = y0;
+  op->arg[2] = x1;
+  op->arg[3] = y1;
+
+  return true;
+}
+
+/**
+ * @brief Record LCD_drawRectangle().
+ *
+ * @param batch batch.
+ * @param x0    starting point on x-axis.
+ * @param y0    starting point on y-axis.
+ * @param x1    ending point on x-axis.
+ * @param y1    ending point on y-axis.
+ */
+bool LCD_batchRectangle(struct LCD_batch *batch, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+  struct LCD_batchOp *op = LCD_batchAdd(batch, LCD_BATCH_RECTANGLE);
+
+  if (!op)
+    return false;
+
+  op->arg[0] = x0;
+  op->arg[1] = y0;
+  op->arg[2] = x1;
+  op->arg[3] = y1;
+
+  return true;
+}
+
+/**
+ * @brief Record LCD_drawTriangle().
+ *
+ * @param batch batch.
+ * @param xA    first vertex on x-axis.
+ * @param yA    first vertex on y-axis.
+ * @param xB    second vertex on x-axis.
+ * @param yB    second vertex on y-axis.
+ * @param xC    third vertex on x-axis.
+ * @param yC    third vertex on y-axis.
+ */
+bool LCD_batchTriangle(struct LCD_batch *batch, uint8_t xA, uint8_t yA, uint8_t xB, uint8_t yB, uint8_t xC, uint8_t yC)
+{
+  struct LCD_batchOp *op = LCD_batchAdd(batch, LCD_BATCH_TRIANGLE);
+
+  if (!op)
+    return false;
+
+  op->arg[0] = xA;
+  op->arg[1] = yA;
+  op->arg[2] = xB;
+  op->arg[3] = yB;
+  op->arg[4] = xC;
+  op->arg[5] = yC;
+
+  return true;
+}
+
+/**
+ * @brief Record LCD_drawCircle().
+ *
+ * @param batch   batch.
+ * @param x0      center on x-axis.
+ * @param y0      center on y-axis.
+ * @param radius  radius.
+ */
+bool LCD_batchCircle(struct LCD_batch *batch, uint8_t x0, uint8_t y0, uint8_t radius)
+{
+  struct LCD_batchOp *op = LCD_batchAdd(batch, LCD_BATCH_CIRCLE);
+
+  if (!op)
+    return false;
+
+  op->arg[0] = x0;
+  op->arg[1] = y0;
+  op->arg[2] = radius;
+
+  return true;
+}
+
+/**
+ * @brief Record LCD_printScaled().
+ *
+ * @param batch   batch.
+ * @param str     string to draw, not copied.
+ * @param x0      starting point on the x-axis.
+ * @param row     row number (multiple of 8 lines).
+ * @param scale   scale factor, 1 - LCD_TEXT_MAX_SCALE.
+ */
+bool LCD_batchPrint(struct LCD_batch *batch, const char *str, uint8_t x0, uint8_t row, uint8_t scale)
+{
+  struct LCD_batchOp *op = LCD_batchAdd(batch, LCD_BATCH_TEXT);
+
+  if (!op)
+    return false;
+
+  // Same range as LCD_printScaled(), rows covered by the text are taken from it
+  if (scale < 1)
+    scale = 1;
+  if (scale > LCD_TEXT_MAX_SCALE)
+    scale = LCD_TEXT_MAX_SCALE;
+
+  op->arg[0] = x0;
+  op->arg[1] = row;
+  op->arg[2] = scale;
+  op->str = str;
+
+  return true;
+}
+
+/**
+ * @brief Check whether lines y0 - y1 (inclusive) reach into the band.
+ *        LCD_setPixel() moves pixels past the screen edge to the last line, so does this.
+ */
+static bool LCD_batchInBand(int16_t y0, int16_t y1, uint8_t top, uint8_t bottom)
+{
+  if (y0 < 0 || y1 >= LCD_HEIGHT)
+    y1 = LCD_HEIGHT - 1;
+  if (y0 < 0)
+    y0 = 0;
+  if (y0 >= LCD_HEIGHT)
+    y0 = LCD_HEIGHT - 1;
+
+  return y1 >= top && y0 < bottom;
+}
+
+/**
+ * @brief Replay a batch in the band of lines top - bottom (exclusive).
+ *        Band clipping itself is done by LCD_setBand(), this skips operations outside of the band.
+ */
+static void LCD_batchReplayBand(const struct LCD_batch *batch, uint8_t top, uint8_t bottom)
+{
+  for (uint8_t i = 0; i < batch->count; i++)
+  {
+    const struct LCD_batchOp *op = &batch->ops[i];
+    const uint8_t *a = op->arg;
+
+    switch (op->type)
+    {
+    case LCD_BATCH_CLEAR:
+      memset(&lcd.target[top / LCD_COLUMN_HEIGHT * LCD_WIDTH], 0, (bottom - top) / LCD_COLUMN_HEIGHT * LCD_WIDTH);
+      break;
+    case LCD_BATCH_PIXEL:
+      LCD_setPixel(a[0], a[1], a[2]);
+      break;
+    case LCD_BATCH_LINE:
+      if (LCD_batchInBand(MIN(a[1], a[3]), MAX(a[1], a[3]), top, bottom))
+        LCD_drawLine(a[0], a[1], a[2], a[3]);
+      break;
+    case LCD_BATCH_RECTANGLE:
+      if (LCD_batchInBand(MIN(a[1], a[3]), MAX(a[1], a[3]), top, bottom))
+        LCD_drawRectangle(a[0], a[1], a[2], a[3]);
+      break;
+    case LCD_BATCH_TRIANGLE:
+      if (LCD_batchInBand(MIN(MIN(a[1], a[3]), a[5]), MAX(MAX(a[1], a[3]), a[5]), top, bottom))
+        LCD_drawTriangle(a[0], a[1], a[2], a[3], a[4], a[5]);
+      break;
+    case LCD_BATCH_CIRCLE:
+      if (LCD_batchInBand(a[1] - a[2], a[1] + a[2], top, bottom))
+        LCD_drawCircle(a[0], a[1], a[2]);
+      break;
+    case LCD_BATCH_TEXT:
+      if (LCD_batchInBand(a[1] * LCD_COLUMN_HEIGHT, (a[1] + a[2]) * LCD_COLUMN_HEIGHT - 1, top, bottom))
+        LCD_printScaled((char *)op->str, a[0], a[1], a[2]);
+      break;
+    }
+  }
+}
+
+/**
+ * @brief Replay a batch on the current core only (no band, e.g. for comparison with LCD_parallelRender()).
+ *
+ * @param batch batch.
+ */
+void LCD_batchReplay(const struct LCD_batch *batch)
+{
+  LCD_batchReplayBand(batch, 0, LCD_HEIGHT);
+}
+
+/**
+ * @brief Core 1 main loop, renders the rows from split to the bottom of every batch it receives.
+ */
+static void LCD_parallelCore1()
+{
+  while (true)
+  {
+    multicore_fifo_pop_blocking();
+
+    const struct LCD_batch *batch = pending;
+    uint32_t start = time_us_32();
+
+    LCD_setBand(split, LCD_ROW_NUMBER - split);
+    LCD_batchReplayBand(batch, split * LCD_COLUMN_HEIGHT, LCD_HEIGHT);
+
+    multicore_fifo_push_blocking(time_us_32() - start);
+  }
+}
+
+/**
+ * @brief Start the render loop on core 1.
+ */
+void LCD_parallelInit()
+{
+  multicore_launch_core1(LCD_parallelCore1);
+}
+
+/**
+ * @brief Set the first row rendered by core 1, rows above it are rendered by core 0.
+ *        Move it to balance the cores when most of the drawing is in the upper or lower part.
+ *
+ * @param row row number, 0 - LCD_ROW_NUMBER.
+ */
+void LCD_parallelSetSplit(uint8_t row)
+{
+  split = row > LCD_ROW_NUMBER ? LCD_ROW_NUMBER : row;
+}
+
+/**
+ * @brief Render a batch in lcd.buffer on both cores.
+ *        Returns when both cores are done, so lcd.buffer can be sent to the LCD right away.
+ *
+ * @param batch batch, mustn't change until the call returns.
+ *
+ * @return per core render times.
+ */
+const struct LCD_parallelTimes *LCD_parallelRender(const struct LCD_batch *batch)
+{
+  uint32_t start = time_us_32();
+
+  // Batch is passed in a variable, FIFO only wakes core 1 up
+  pending = batch;
+  multicore_fifo_push_blocking(1);
+
+  LCD_setBand(0, split);
+  LCD_batchReplayBand(batch, 0, split * LCD_COLUMN_HEIGHT);
+  times.coreUs[0] = time_us_32() - start;
+  LCD_setBand(0, LCD_ROW_NUMBER);
+
+  times.coreUs[1] = multicore_fifo_pop_blocking();
+  times.totalUs = time_us_32() - start;
+
+  // Both cores update lcd.targetDirty without a lock, bits may be lost
+  lcd.targetDirty = (1 << LCD_ROW_NUMBER) - 1;
+
+  return &times;
+}
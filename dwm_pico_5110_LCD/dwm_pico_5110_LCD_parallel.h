@@ -0,0 +1,93 @@
+/*
+ * File: dwm_pico_5110_LCD_parallel.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#ifndef DWM_PICO_5110_LCD_PARALLEL
+#define DWM_PICO_5110_LCD_PARALLEL
+
+#include "dwm_pico_5110_LCD.h"
+
+/*
+ * Parallel rendering on both RP2040 cores. Draw calls are recorded in a batch,
+ * both cores replay the whole batch, each one clipped to its own band of rows
+ * (LCD_setBand()), so lcd.buffer needs no locks. Operations outside of a band
+ * are skipped by their bounding box.
+ *
+ * Core 1 is taken by LCD_parallelInit(), link the executable with pico_multicore.
+ * Performance counters (LCD_ENABLE_STATS) aren't exact while both cores draw.
+ */
+
+#define LCD_BATCH_MAX_OPS 64
+
+/**
+ * @brief Recorded draw operations.
+ */
+enum LCD_batchOpType
+{
+	LCD_BATCH_CLEAR,
+	LCD_BATCH_PIXEL,
+	LCD_BATCH_LINE,
+	LCD_BATCH_RECTANGLE,
+	LCD_BATCH_TRIANGLE,
+	LCD_BATCH_CIRCLE,
+	LCD_BATCH_TEXT
+};
+
+/**
+ * @brief One draw call, arguments in the order of the draw function.
+ */
+struct LCD_batchOp
+{
+	uint8_t type;
+	uint8_t arg[6];
+	const char *str;
+};
+
+/**
+ * @brief Draw batch.
+ */
+struct LCD_batch
+{
+	struct LCD_batchOp ops[LCD_BATCH_MAX_OPS];
+	uint8_t count;
+};
+
+/**
+ * @brief Timings of the last parallel render.
+ */
+struct LCD_parallelTimes
+{
+	uint32_t coreUs[2];
+	uint32_t totalUs;
+};
+
+/*----- Batch recording -----*/
+/*
+ * These functions return false when the batch is full. Strings aren't copied,
+ * they have to stay valid until the batch is rendered.
+ */
+
+void LCD_batchReset(struct LCD_batch *batch);
+bool LCD_batchClrBuff(struct LCD_batch *batch);
+bool LCD_batchPixel(struct LCD_batch *batch, uint8_t x0, uint8_t y0, bool mode);
+bool LCD_batchLine(struct LCD_batch *batch, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+bool LCD_batchRectangle(struct LCD_batch *batch, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+bool LCD_batchTriangle(struct LCD_batch *batch, uint8_t xA, uint8_t yA, uint8_t xB, uint8_t yB, uint8_t xC, uint8_t yC);
+bool LCD_batchCircle(struct LCD_batch *batch, uint8_t x0, uint8_t y0, uint8_t radius);
+bool LCD_batchPrint(struct LCD_batch *batch, const char *str, uint8_t x0, uint8_t row, uint8_t scale);
+
+/*----- Rendering -----*/
+
+void LCD_batchReplay(const struct LCD_batch *batch);
+void LCD_parallelInit();
+void LCD_parallelSetSplit(uint8_t row);
+const struct LCD_parallelTimes *LCD_parallelRender(const struct LCD_batch *batch);
+
+#endif
@@ -0,0 +1,204 @@
+/*
+ * File: dwm_pico_5110_LCD_rowmajor.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#include <string.h>
+
+#include "dwm_pico_5110_LCD_rowmajor.h"
+
+struct LCD_rowFrame lcd_row;
+
+extern struct LCD_att lcd;
+
+/**
+ * @brief Clears lcd_row.buffer.
+ */
+void LCD_rowClrBuff()
+{
+  memset(lcd_row.buffer, 0, LCD_ROW_FRAME_SIZE);
+}
+
+/**
+ * @brief Convert lcd_row.buffer into lcd.buffer layout, 8x8 pixels at a time.
+ *
+ * @param frame destination, LCD_SIZE bytes, NULL = lcd.buffer (or current draw target).
+ */
+void LCD_rowToBuffer(uint8_t *frame)
+{
+  uint8_t block[LCD_COLUMN_HEIGHT];
+
+  if (!frame)
+  {
+    frame = lcd.target;
+    lcd.targetDirty = (1 << LCD_ROW_NUMBER) - 1;
+  }
+
+  for (uint8_t row = 0; row < LCD_ROW_NUMBER; row++)
+    for (uint8_t i = 0; i < LCD_ROW_BYTES; i++)
+    {
+      uint8_t *dst = &frame[row * LCD_WIDTH + i * 8];
+      uint8_t width = LCD_WIDTH - i * 8 < 8 ? LCD_WIDTH - i * 8 : 8;
+
+      LCD_transpose8(&lcd_row.buffer[row * LCD_COLUMN_HEIGHT * LCD_ROW_BYTES + i], LCD_ROW_BYTES, block, 1);
+
+      // Most significant bit is the leftmost pixel, so transposed columns come in reverse order
+      for (uint8_t j = 0; j < width; j++)
+        dst[j] = block[7 - j];
+    }
+}
+
+/**
+ * @brief Updates the entire screen according to lcd_row.buffer.
+ *        Frame is transposed into the library's stream buffer, so no extra RAM is needed.
+ */
+void LCD_rowRefreshScr()
+{
+  uint8_t *frame = LCD_getStreamBuffer();
+
+  LCD_rowToBuffer(frame);
+  LCD_refreshFrame(frame);
+}
+
+/**
+ * @brief Sets a pixel in lcd_row.buffer.
+ *
+ * @param x0    pixel location on x axis.
+ * @param y0    pixel location on y axis.
+ * @param mode  true = lit pixel / false = dim pixel.
+ */
+void LCD_rowSetPixel(uint8_t x0, uint8_t y0, bool mode)
+{
+  if (x0 >= LCD_WIDTH)
+    x0 = LCD_WIDTH - 1;
+  if (y0 >= LCD_HEIGHT)
+    y0 = LCD_HEIGHT - 1;
+
+  if (mode)
+    lcd_row.buffer[y0 * LCD_ROW_BYTES + x0 / 8] |= 0x80 >> (x0 % 8);
+  else
+    lcd_row.buffer[y0 * LCD_ROW_BYTES + x0 / 8] &= ~(0x80 >> (x0 % 8));
+}
+
+/**
+ * @brief Get pixel state in lcd_row.buffer.
+ *
+ * @param x0 pixel location on x axis.
+ * @param y0 pixel location on y axis.
+ * @return  true = pixel is lit / false = pixel is dimmed.
+ */
+bool LCD_rowGetPixel(uint8_t x0, uint8_t y0)
+{
+  return lcd_row.buffer[y0 * LCD_ROW_BYTES + x0 / 8] >> (7 - x0 % 8) & 1;
+}
+
+/**
+ * @brief Draws a horizontal line, whole bytes are filled at once.
+ *
+ * @param x0    starting point on the x-axis.
+ * @param x1    ending point on the x-axis (inclusive).
+ * @param y0    line position on the y-axis.
+ * @param mode  true = lit pixels / false = dim pixels.
+ */
+void LCD_rowDrawHLine(uint8_t x0, uint8_t x1, uint8_t y0, bool mode)
+{
+  if (x0 > x1)
+  {
+    uint8_t tmp = x0;
+    x0 = x1;
+    x1 = tmp;
+  }
+  if (x1 >= LCD_WIDTH)
+    x1 = LCD_WIDTH - 1;
+  if (x0 > x1 || y0 >= LCD_HEIGHT)
+    return;
+
+  uint8_t *line = &lcd_row.buffer[y0 * LCD_ROW_BYTES];
+  uint8_t first = x0 / 8;
+  uint8_t last = x1 / 8;
+  uint8_t firstMask = 0xFF >> (x0 % 8);
+  uint8_t lastMask = 0xFF << (7 - x1 % 8);
+
+  if (first == last)
+    firstMask &= lastMask;
+
+  line[first] = mode ? line[first] | firstMask : line[first] & ~firstMask;
+
+  if (first == last)
+    return;
+
+  memset(&line[first + 1], mode ? 0xFF : 0x00, last - first - 1);
+  line[last] = mode ? line[last] | lastMask : line[last] & ~lastMask;
+}
+
+/**
+ * @brief Fills a rectangle.
+ *
+ * @param x0    starting point on the x-axis.
+ * @param y0    starting point on the y-axis.
+ * @param x1    ending point on the x-axis (inclusive).
+ * @param y1    ending point on the y-axis (inclusive).
+ * @param mode  true = lit pixels / false = dim pixels.
+ */
+void LCD_rowFillRectangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool mode)
+{
+  if (y0 > y1)
+  {
+    uint8_t tmp = y0;
+    y0 = y1;
+    y1 = tmp;
+  }
+  if (y1 >= LCD_HEIGHT)
+    y1 = LCD_HEIGHT - 1;
+
+  for (uint16_t y = y0; y <= y1; y++)
+    LCD_rowDrawHLine(x0, x1, y, mode);
+}
+
+/**
+ * @brief Draws a row-major 1bpp image (MSB is the leftmost pixel, lines padded to whole bytes).
+ *        Lit image pixels are OR'ed into the buffer.
+ *
+ * @param image   image data.
+ * @param width   image width in pixels.
+ * @param height  image height in pixels.
+ * @param x0      image position on the x-axis.
+ * @param y0      image position on the y-axis.
+ */
+void LCD_rowDrawImage(const uint8_t *image, uint8_t width, uint8_t height, uint8_t x0, uint8_t y0)
+{
+  uint8_t imageBytes = (width + 7) / 8;
+  uint8_t shift = x0 % 8;
+
+  if (x0 >= LCD_WIDTH || y0 >= LCD_HEIGHT)
+    return;
+  if (x0 + width > LCD_WIDTH)
+    width = LCD_WIDTH - x0;
+  if (y0 + height > LCD_HEIGHT)
+    height = LCD_HEIGHT - y0;
+
+  uint8_t bytes = (width + 7) / 8;
+  uint8_t lastMask = 0xFF << ((8 - width % 8) % 8);
+
+  for (uint8_t y = 0; y < height; y++)
+  {
+    const uint8_t *src = &image[y * imageBytes];
+    uint8_t *dst = &lcd_row.buffer[(y0 + y) * LCD_ROW_BYTES + x0 / 8];
+
+    for (uint8_t i = 0; i < bytes; i++)
+    {
+      uint8_t byte = i == bytes - 1 ? src[i] & lastMask : src[i];
+
+      // Unaligned images are split over two buffer bytes
+      dst[i] |= byte >> shift;
+      if (shift && byte << (8 - shift) & 0xFF)
+        dst[i + 1] |= byte << (8 - shift);
+    }
+  }
+}
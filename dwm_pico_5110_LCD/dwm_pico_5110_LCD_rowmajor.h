@@ -0,0 +1,53 @@
+/*
+ * File: dwm_pico_5110_LCD_rowmajor.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#ifndef DWM_PICO_5110_LCD_ROWMAJOR
+#define DWM_PICO_5110_LCD_ROWMAJOR
+
+#include "dwm_pico_5110_LCD.h"
+
+/*
+ * Row-major framebuffer. Every line of the screen takes LCD_ROW_BYTES bytes,
+ * most significant bit is the leftmost pixel (same as PBM and most 1bpp image formats).
+ * Horizontal spans are plain byte fills here, the frame is transposed into
+ * LCD's vertical byte layout when it is sent.
+ */
+
+#define LCD_ROW_BYTES ((LCD_WIDTH + 7) / 8)
+#define LCD_ROW_FRAME_SIZE (LCD_ROW_BYTES * LCD_HEIGHT)
+
+/**
+ * @brief Row-major frame.
+ */
+struct LCD_rowFrame
+{
+	uint8_t buffer[LCD_ROW_FRAME_SIZE];
+};
+
+extern struct LCD_rowFrame lcd_row;
+
+/*----- Draw Functions -----*/
+/*
+ * These functions draw in lcd_row.buffer. It's necessary to use LCD_rowRefreshScr()
+ * in order to send data to the LCD, or LCD_rowToBuffer(NULL) to copy the frame
+ * in lcd.buffer (or current draw target, e.g. a layer).
+ */
+
+void LCD_rowClrBuff();
+void LCD_rowRefreshScr();
+void LCD_rowToBuffer(uint8_t *frame);
+void LCD_rowSetPixel(uint8_t x0, uint8_t y0, bool mode);
+bool LCD_rowGetPixel(uint8_t x0, uint8_t y0);
+void LCD_rowDrawHLine(uint8_t x0, uint8_t x1, uint8_t y0, bool mode);
+void LCD_rowFillRectangle(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool mode);
+void LCD_rowDrawImage(const uint8_t *image, uint8_t width, uint8_t height, uint8_t x0, uint8_t y0);
+
+#endif
@@ -0,0 +1,126 @@
+/*
+ * File: dwm_pico_5110_LCD_text.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#include "dwm_pico_5110_LCD_text.h"
+
+// Sent cell that never matches the grid
+#define LCD_TEXT_UNKNOWN 0xFFFF
+
+struct LCD_textMode lcd_text;
+
+extern struct LCD_att lcd;
+
+/**
+ * @brief Initialize text mode, grid is cleared and the whole screen is sent on next flush.
+ */
+void LCD_textInit()
+{
+  LCD_textClear();
+  LCD_textInvalidate();
+}
+
+/**
+ * @brief Fill the grid with spaces.
+ */
+void LCD_textClear()
+{
+  for (uint8_t row = 0; row < LCD_TEXT_ROWS; row++)
+    for (uint8_t column = 0; column < LCD_TEXT_COLUMNS; column++)
+      lcd_text.cells[row][column] = LCD_TEXT_CELL(' ', 0);
+}
+
+/**
+ * @brief Forget what was sent, e.g. after the screen was changed by other functions.
+ */
+void LCD_textInvalidate()
+{
+  for (uint8_t row = 0; row < LCD_TEXT_ROWS; row++)
+    for (uint8_t column = 0; column < LCD_TEXT_COLUMNS; column++)
+      lcd_text.sent[row][column] = LCD_TEXT_UNKNOWN;
+}
+
+/**
+ * @brief Put a char in the grid, inverted if lcd.invertText is set.
+ *
+ * @param c       char to put.
+ * @param column  column of the grid.
+ * @param row     row of the grid.
+ */
+void LCD_textPutChar(char c, uint8_t column, uint8_t row)
+{
+  if (column >= LCD_TEXT_COLUMNS || row >= LCD_TEXT_ROWS)
+    return;
+
+  lcd_text.cells[row][column] = LCD_TEXT_CELL(c, lcd.invertText ? LCD_TEXT_INVERTED : 0);
+}
+
+/**
+ * @brief Put a string in the grid, cut at the end of the row.
+ *
+ * @param str     string to put.
+ * @param column  starting column of the grid.
+ * @param row     row of the grid.
+ */
+void LCD_textPrint(char *str, uint8_t column, uint8_t row)
+{
+  while (*str && column < LCD_TEXT_COLUMNS)
+    LCD_textPutChar(*str++, column++, row);
+}
+
+/**
+ * @brief Draw a cell in lcd.buffer (or current draw target).
+ */
+static void LCD_textDrawCell(uint16_t cell, uint8_t column, uint8_t row)
+{
+  const uint8_t *glyph = ASCII[(cell & 0xFF) - 0x20];
+  uint8_t *dst = &lcd.target[row * LCD_WIDTH + column * FONT_SYMBOL_WIDTH];
+
+  for (uint8_t i = 0; i < FONT_SYMBOL_WIDTH; i++)
+    dst[i] = cell & LCD_TEXT_INVERTED ? ~glyph[i] : glyph[i];
+
+  lcd.targetDirty |= 1 << row;
+}
+
+/**
+ * @brief Send changed cells to the LCD, every run of changed cells in a row is one transfer.
+ *
+ * @return number of cells sent.
+ */
+uint8_t LCD_textFlush()
+{
+  uint8_t sent = 0;
+
+  for (uint8_t row = 0; row < LCD_TEXT_ROWS; row++)
+    for (uint8_t column = 0; column < LCD_TEXT_COLUMNS;)
+    {
+      uint8_t start = column;
+
+      while (column < LCD_TEXT_COLUMNS && lcd_text.cells[row][column] != lcd_text.sent[row][column])
+      {
+        LCD_textDrawCell(lcd_text.cells[row][column], column, row);
+        lcd_text.sent[row][column] = lcd_text.cells[row][column];
+        column++;
+      }
+
+      if (column == start)
+      {
+        column++;
+        continue;
+      }
+
+      // Drawn in a layer, composing sends it
+      if (lcd.target == lcd.buffer)
+        LCD_refreshArea(start * FONT_SYMBOL_WIDTH, column * FONT_SYMBOL_WIDTH, row, 1);
+      sent += column - start;
+    }
+
+  return sent;
+}
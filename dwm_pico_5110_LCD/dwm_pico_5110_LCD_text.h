@@ -0,0 +1,51 @@
+/*
+ * File: dwm_pico_5110_LCD_text.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#ifndef DWM_PICO_5110_LCD_TEXT
+#define DWM_PICO_5110_LCD_TEXT
+
+#include "dwm_pico_5110_LCD.h"
+
+/*
+ * Character-cell text mode. The screen is a grid of LCD_TEXT_COLUMNS x LCD_TEXT_ROWS
+ * cells, writes only change the grid. LCD_textFlush() compares it with the cells last
+ * sent and sends every run of changed cells in a row with one goXY and one transfer.
+ * Glyphs are drawn in lcd.buffer as well, so rotation and mirroring apply.
+ */
+
+#define LCD_TEXT_COLUMNS LCD_LETTERS_IN_ROW
+#define LCD_TEXT_ROWS LCD_ROW_NUMBER
+
+// Cell is a char and attributes
+#define LCD_TEXT_INVERTED 0x100
+#define LCD_TEXT_CELL(c, attr) ((uint8_t)(c) | (attr))
+
+/**
+ * @brief Text grid and cells as they were last sent.
+ */
+struct LCD_textMode
+{
+	uint16_t cells[LCD_TEXT_ROWS][LCD_TEXT_COLUMNS];
+	uint16_t sent[LCD_TEXT_ROWS][LCD_TEXT_COLUMNS];
+};
+
+extern struct LCD_textMode lcd_text;
+
+/*----- Text mode Functions -----*/
+
+void LCD_textInit();
+void LCD_textClear();
+void LCD_textInvalidate();
+void LCD_textPutChar(char c, uint8_t column, uint8_t row);
+void LCD_textPrint(char *str, uint8_t column, uint8_t row);
+uint8_t LCD_textFlush();
+
+#endif
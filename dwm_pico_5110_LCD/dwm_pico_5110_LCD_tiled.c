@@ -0,0 +1,465 @@
+/*
+ * File: dwm_pico_5110_LCD_tiled.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#include <string.h>
+
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "hardware/gpio.h"
+#include "hardware/dma.h"
+
+#include "dwm_pico_5110_LCD_tiled.h"
+
+#define STATE_HIGH 1
+#define STATE_LOW 0
+
+struct LCD_tiled lcd_tiled;
+
+// Flipped spans are reordered here, one row per interface as they are sent at the same time
+static uint8_t staged[LCD_TILED_SPI_COUNT][LCD_WIDTH];
+
+/**
+ * @brief Write commands to a panel.
+ *
+ * @param panel     panel.
+ * @param commands  commands to be written.
+ * @param size      number of commands.
+ */
+static void LCD_tiledWriteCommands(struct LCD_panel *panel, const uint8_t *commands, uint8_t size)
+{
+  gpio_put(panel->DC, STATE_LOW);
+  gpio_put(panel->SCE, STATE_LOW);
+  spi_write_blocking(panel->spi, commands, size);
+  gpio_put(panel->SCE, STATE_HIGH);
+}
+
+/**
+ * @brief Mark columns of a panel row as changed.
+ *
+ * @param panel panel.
+ * @param x0    first column.
+ * @param x1    last column (exclusive).
+ * @param row   row (multiple of 8 lines).
+ */
+static void LCD_tiledMarkDirty(struct LCD_panel *panel, uint8_t x0, uint8_t x1, uint8_t row)
+{
+  if (x0 < panel->dirtyLeft[row])
+    panel->dirtyLeft[row] = x0;
+  if (x1 > panel->dirtyRight[row])
+    panel->dirtyRight[row] = x1;
+}
+
+/**
+ * @brief Mark every panel as changed.
+ */
+static void LCD_tiledMarkAll()
+{
+  for (uint8_t i = 0; i < lcd_tiled.columns * lcd_tiled.rows; i++)
+    for (uint8_t row = 0; row < LCD_ROW_NUMBER; row++)
+      LCD_tiledMarkDirty(&lcd_tiled.panels[i], 0, LCD_WIDTH, row);
+}
+
+static bool LCD_tiledFlipX()
+{
+  return (lcd_tiled.rotation == LCD_ROTATE_180) != lcd_tiled.mirrorX;
+}
+
+static bool LCD_tiledFlipY()
+{
+  return (lcd_tiled.rotation == LCD_ROTATE_180) != lcd_tiled.mirrorY;
+}
+
+/**
+ * @brief Get the panel showing a part of the canvas.
+ *
+ * @param index canvas part, index of the panel showing it with no orientation.
+ *
+ * @return panel.
+ */
+static struct LCD_panel *LCD_tiledTarget(uint8_t index)
+{
+  uint8_t column = index % lcd_tiled.columns;
+  uint8_t row = index / lcd_tiled.columns;
+
+  if (LCD_tiledFlipX())
+    column = lcd_tiled.columns - 1 - column;
+  if (LCD_tiledFlipY())
+    row = lcd_tiled.rows - 1 - row;
+
+  return &lcd_tiled.panels[row * lcd_tiled.columns + column];
+}
+
+/**
+ * @brief Initialize the canvas and all its panels.
+ *
+ * @attention Must initialise SPI interfaces first! Max supported speed is 4MHZ (LCD_SPI_MAX_SPEED)
+ *
+ * @param panels  panels, row by row, columns * rows entries with spi and pins set.
+ * @param columns number of panels in a row.
+ * @param rows    number of panel rows.
+ * @param RST     RST (reset) pin shared by all panels.
+ * @param config  contrast, bias and temperature coefficient of all panels (as in LCD_initConfig()),
+ *                NULL = LCD_CONFIG_DEFAULT. Splash is not used, the canvas starts cleared.
+ */
+void LCD_tiledInit(struct LCD_panel *panels, uint8_t columns, uint8_t rows, uint16_t RST, const struct LCD_config *config)
+{
+  static const struct LCD_config defaults = LCD_CONFIG_DEFAULT;
+
+  if (!config)
+    config = &defaults;
+
+  const uint8_t init[] = {
+      LCD_FUNCTION_SET | LCD_EXTENDED_INSTRUCTIONS,
+      LCD_SET_VOP | (config->contrast & 0x7F),
+      LCD_SET_TEMPERATURE | (config->temperature & 0x03),
+      LCD_SET_BIAS | (config->bias & 0x07),
+      LCD_FUNCTION_SET,
+      LCD_DISPLAY_NORMAL,
+  };
+
+  lcd_tiled.panels = panels;
+  lcd_tiled.columns = columns;
+  lcd_tiled.rows = rows;
+  lcd_tiled.width = columns * LCD_WIDTH;
+  lcd_tiled.height = rows * LCD_HEIGHT;
+  lcd_tiled.RST = RST;
+  lcd_tiled.invertText = false;
+  lcd_tiled.rotation = LCD_ROTATE_0;
+  lcd_tiled.mirrorX = false;
+  lcd_tiled.mirrorY = false;
+
+  for (uint8_t i = 0; i < columns * rows; i++)
+  {
+    gpio_init(panels[i].SCE);
+    gpio_set_dir(panels[i].SCE, GPIO_OUT);
+    gpio_put(panels[i].SCE, STATE_HIGH);
+
+    gpio_init(panels[i].DC);
+    gpio_set_dir(panels[i].DC, GPIO_OUT);
+
+    gpio_set_function(panels[i].DIN, GPIO_FUNC_SPI);
+    gpio_set_function(panels[i].SCLK, GPIO_FUNC_SPI);
+  }
+
+  // One DMA channel per SPI interface, so panels on different interfaces are sent in parallel
+  for (uint8_t i = 0; i < LCD_TILED_SPI_COUNT; i++)
+    lcd_tiled.dma[i] = -1;
+  for (uint8_t i = 0; i < columns * rows; i++)
+  {
+    uint8_t bus = spi_get_index(panels[i].spi);
+
+    if (lcd_tiled.dma[bus] < 0)
+      lcd_tiled.dma[bus] = dma_claim_unused_channel(true);
+  }
+
+  // Reset screen registers
+  gpio_init(RST);
+  gpio_set_dir(RST, GPIO_OUT);
+  gpio_put(RST, STATE_LOW);
+  sleep_us(1);
+  gpio_put(RST, STATE_HIGH);
+
+  for (uint8_t i = 0; i < columns * rows; i++)
+    LCD_tiledWriteCommands(&panels[i], init, sizeof(init));
+
+  LCD_tiledClrBuff();
+  LCD_tiledRefresh();
+}
+
+/**
+ * @brief Invert the colour of text drawn on the canvas.
+ *
+ * @param mode: true = inverted / false = normal.
+ */
+void LCD_tiledInvertText(bool mode)
+{
+  lcd_tiled.invertText = mode;
+}
+
+/**
+ * @brief Set orientation of the canvas, applied when it's sent.
+ *        Whole canvas is sent again on the next refresh.
+ *
+ * @attention LCD_ROTATE_90 and LCD_ROTATE_270 would swap the geometry, they are treated as LCD_ROTATE_0.
+ *
+ * @param rotation  clockwise rotation.
+ * @param mirrorX   true = mirror horizontally.
+ * @param mirrorY   true = mirror vertically.
+ */
+void LCD_tiledSetOrientation(enum LCD_rotation rotation, bool mirrorX, bool mirrorY)
+{
+  lcd_tiled.rotation = rotation;
+  lcd_tiled.mirrorX = mirrorX;
+  lcd_tiled.mirrorY = mirrorY;
+
+  LCD_tiledMarkAll();
+}
+
+/**
+ * @brief Get canvas width.
+ *
+ * @return width in pixels.
+ */
+uint16_t LCD_tiledWidth()
+{
+  return lcd_tiled.width;
+}
+
+/**
+ * @brief Get canvas height.
+ *
+ * @return height in pixels.
+ */
+uint16_t LCD_tiledHeight()
+{
+  return lcd_tiled.height;
+}
+
+/**
+ * @brief Clears buffers of all panels.
+ */
+void LCD_tiledClrBuff()
+{
+  for (uint8_t i = 0; i < lcd_tiled.columns * lcd_tiled.rows; i++)
+    memset(lcd_tiled.panels[i].buffer, 0, LCD_SIZE);
+
+  LCD_tiledMarkAll();
+}
+
+/**
+ * @brief Start sending the next changed span of panels on an interface.
+ *        Full width rows next to each other are sent at once.
+ *
+ * @param bus SPI interface index.
+ *
+ * @return panel the span is sent to, NULL when nothing changed.
+ */
+static struct LCD_panel *LCD_tiledStart(uint8_t bus)
+{
+  bool flipX = LCD_tiledFlipX();
+  bool flipY = LCD_tiledFlipY();
+
+  for (uint8_t i = 0; i < lcd_tiled.columns * lcd_tiled.rows; i++)
+  {
+    struct LCD_panel *source = &lcd_tiled.panels[i];
+    struct LCD_panel *target = LCD_tiledTarget(i);
+    uint8_t row = 0;
+    uint8_t nRow = 1;
+
+    if (spi_get_index(target->spi) != bus)
+      continue;
+
+    while (row < LCD_ROW_NUMBER && source->dirtyLeft[row] >= source->dirtyRight[row])
+      row++;
+    if (row == LCD_ROW_NUMBER)
+      continue;
+
+    uint8_t x0 = source->dirtyLeft[row];
+    uint8_t x1 = source->dirtyRight[row];
+    const uint8_t *data = &source->buffer[row * LCD_WIDTH + x0];
+
+    if (flipX || flipY)
+    {
+      for (uint8_t j = 0; j < x1 - x0; j++)
+      {
+        uint8_t byte = flipX ? source->buffer[row * LCD_WIDTH + x1 - 1 - j] : data[j];
+        staged[bus][j] = flipY ? lcd_bitReverse[byte] : byte;
+      }
+      data = staged[bus];
+    }
+    else if (x1 - x0 == LCD_WIDTH)
+      while (row + nRow < LCD_ROW_NUMBER && source->dirtyLeft[row + nRow] == 0 && source->dirtyRight[row + nRow] == LCD_WIDTH)
+        nRow++;
+
+    for (uint8_t j = row; j < row + nRow; j++)
+    {
+      source->dirtyLeft[j] = LCD_WIDTH;
+      source->dirtyRight[j] = 0;
+    }
+
+    const uint8_t address[] = {
+        LCD_SETXADDR | (flipX ? LCD_WIDTH - x1 : x0),
+        LCD_SETYADDR | (flipY ? LCD_ROW_NUMBER - 1 - row : row),
+    };
+
+    dma_channel_config config = dma_channel_get_default_config(lcd_tiled.dma[bus]);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_8);
+    channel_config_set_dreq(&config, spi_get_dreq(target->spi, true));
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, false);
+
+    LCD_tiledWriteCommands(target, address, sizeof(address));
+
+    gpio_put(target->DC, STATE_HIGH);
+    gpio_put(target->SCE, STATE_LOW);
+    dma_channel_configure(lcd_tiled.dma[bus], &config, &spi_get_hw(target->spi)->dr, data, (x1 - x0) * nRow, true);
+
+    return target;
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief Sends changed spans of all panels. Panels on different SPI interfaces are sent at the same time.
+ */
+void LCD_tiledRefresh()
+{
+  struct LCD_panel *active[LCD_TILED_SPI_COUNT];
+  bool pending = true;
+
+  while (pending)
+  {
+    pending = false;
+
+    // Start next changed span on every interface
+    for (uint8_t bus = 0; bus < LCD_TILED_SPI_COUNT; bus++)
+      active[bus] = lcd_tiled.dma[bus] < 0 ? NULL : LCD_tiledStart(bus);
+
+    // Wait for all of them
+    for (uint8_t bus = 0; bus < LCD_TILED_SPI_COUNT; bus++)
+    {
+      if (!active[bus])
+        continue;
+
+      // DMA finishes when the last byte enters the FIFO, SPI has to shift it out
+      dma_channel_wait_for_finish_blocking(lcd_tiled.dma[bus]);
+      while (spi_is_busy(active[bus]->spi))
+        tight_loop_contents();
+
+      gpio_put(active[bus]->SCE, STATE_HIGH);
+      pending = true;
+    }
+  }
+}
+
+/**
+ * @brief Sets a pixel on the canvas. Pixels outside the canvas are ignored.
+ *
+ * @param x0    pixel location on x axis.
+ * @param y0    pixel location on y axis.
+ * @param mode  true = lit pixel / false = dim pixel.
+ */
+void LCD_tiledSetPixel(int16_t x0, int16_t y0, bool mode)
+{
+  if (x0 < 0 || y0 < 0 || x0 >= lcd_tiled.width || y0 >= lcd_tiled.height)
+    return;
+
+  struct LCD_panel *panel = &lcd_tiled.panels[(y0 / LCD_HEIGHT) * lcd_tiled.columns + x0 / LCD_WIDTH];
+  uint8_t x = x0 % LCD_WIDTH;
+  uint8_t y = y0 % LCD_HEIGHT;
+  uint8_t *byte = &panel->buffer[x + (y / LCD_COLUMN_HEIGHT) * LCD_WIDTH];
+  uint8_t value = mode ? *byte | 1 << (y % LCD_COLUMN_HEIGHT) : *byte & ~(1 << (y % LCD_COLUMN_HEIGHT));
+
+  if (value != *byte)
+  {
+    *byte = value;
+    LCD_tiledMarkDirty(panel, x, x + 1, y / LCD_COLUMN_HEIGHT);
+  }
+}
+
+/**
+ * @brief Get pixel state on the canvas.
+ *
+ * @param x0 pixel location on x axis.
+ * @param y0 pixel location on y axis.
+ * @return  true = pixel is lit / false = pixel is dimmed or outside the canvas.
+ */
+bool LCD_tiledGetPixel(int16_t x0, int16_t y0)
+{
+  if (x0 < 0 || y0 < 0 || x0 >= lcd_tiled.width || y0 >= lcd_tiled.height)
+    return false;
+
+  struct LCD_panel *panel = &lcd_tiled.panels[(y0 / LCD_HEIGHT) * lcd_tiled.columns + x0 / LCD_WIDTH];
+  uint8_t x = x0 % LCD_WIDTH;
+  uint8_t y = y0 % LCD_HEIGHT;
+
+  return panel->buffer[x + (y / LCD_COLUMN_HEIGHT) * LCD_WIDTH] >> (y % LCD_COLUMN_HEIGHT) & 1;
+}
+
+/**
+ * @brief Draw a run of a line on the canvas, LCD_lineRuns() callback.
+ */
+static void LCD_tiledLineRun(void *context, int16_t x0, int16_t y0, uint32_t length, bool horizontal, int8_t step)
+{
+  int16_t *position = horizontal ? &x0 : &y0;
+
+  (void)context;
+
+  for (uint32_t i = 0; i < length; i++, *position += step)
+    LCD_tiledSetPixel(x0, y0, true);
+}
+
+/**
+ * @brief Draws any line on the canvas, based on Bresenham's line algorithm (LCD_lineRuns()).
+ *
+ * @param x0 starting point on the x-axis.
+ * @param y0 starting point on the y-axis.
+ * @param x1 ending point on the x-axis.
+ * @param y1 ending point on the y-axis.
+ */
+void LCD_tiledDrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+  LCD_lineRuns(x0, y0, x1, y1, LCD_tiledLineRun, NULL);
+}
+
+/**
+ * @brief Draws a rectangle on the canvas.
+ *
+ * @param x0 starting point on the x-axis.
+ * @param y0 starting point on the y-axis.
+ * @param x1 ending point on the x-axis.
+ * @param y1 ending point on the y-axis.
+ */
+void LCD_tiledDrawRectangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1)
+{
+  LCD_tiledDrawLine(x0, y0, x1, y0);
+  LCD_tiledDrawLine(x0, y0, x0, y1);
+  LCD_tiledDrawLine(x1, y0, x1, y1);
+  LCD_tiledDrawLine(x0, y1, x1, y1);
+}
+
+/**
+ * @brief Draws one char on the canvas, at any pixel position.
+ *
+ * @param c   char to be drawn.
+ * @param x0  top left corner on the x-axis.
+ * @param y0  top left corner on the y-axis.
+ */
+void LCD_tiledPutChar(char c, int16_t x0, int16_t y0)
+{
+  for (uint8_t i = 0; i < FONT_SYMBOL_WIDTH; i++)
+  {
+    uint8_t column = ASCII[c - 0x20][i];
+
+    if (lcd_tiled.invertText)
+      column = ~column;
+
+    for (uint8_t j = 0; j < LCD_COLUMN_HEIGHT; j++)
+      LCD_tiledSetPixel(x0 + i, y0 + j, column >> j & 1);
+  }
+}
+
+/**
+ * @brief Draws a string on the canvas, at any pixel position.
+ *
+ * @param str string to draw.
+ * @param x0  top left corner on the x-axis.
+ * @param y0  top left corner on the y-axis.
+ */
+void LCD_tiledPrint(char *str, int16_t x0, int16_t y0)
+{
+  while (*str)
+  {
+    LCD_tiledPutChar(*str++, x0, y0);
+    x0 += FONT_SYMBOL_WIDTH;
+  }
+}
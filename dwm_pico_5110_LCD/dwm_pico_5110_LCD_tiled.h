@@ -0,0 +1,93 @@
+/*
+ * File: dwm_pico_5110_LCD_tiled.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#ifndef DWM_PICO_5110_LCD_TILED
+#define DWM_PICO_5110_LCD_TILED
+
+#include "dwm_pico_5110_LCD.h"
+
+/*
+ * Virtual canvas made of several panels placed side by side.
+ * Drawing uses one coordinate space of (columns * LCD_WIDTH) x (rows * LCD_HEIGHT) pixels,
+ * every panel keeps its own buffer and the columns changed in each of its rows,
+ * only changed spans are sent.
+ * Panels on different SPI interfaces are sent at the same time (DMA), panels sharing
+ * an interface share DIN and SCLK, each panel needs its own SCE pin.
+ * D/C pin may be shared by panels on the same interface only.
+ *
+ * Orientation (LCD_tiledSetOrientation()) applies to the whole canvas when it's sent,
+ * e.g. LCD_ROTATE_180 also swaps the panels.
+ * Transfers are not counted in LCD_getStats() and not kept in LCD_getShadow(),
+ * both describe the panel driven by lcd only.
+ *
+ * Requires hardware_dma library.
+ */
+
+#define LCD_TILED_SPI_COUNT 2
+
+/**
+ * @brief Single panel of the canvas.
+ */
+struct LCD_panel
+{
+	spi_inst_t *spi;
+	uint16_t SCE;
+	uint16_t DC;
+	uint16_t DIN;
+	uint16_t SCLK;
+	uint8_t buffer[LCD_SIZE];
+	// Columns changed in every row, right exclusive (left == LCD_WIDTH when unchanged)
+	uint8_t dirtyLeft[LCD_ROW_NUMBER];
+	uint8_t dirtyRight[LCD_ROW_NUMBER];
+};
+
+/**
+ * @brief Canvas parameters.
+ */
+struct LCD_tiled
+{
+	struct LCD_panel *panels;
+	uint8_t columns;
+	uint8_t rows;
+	uint16_t width;
+	uint16_t height;
+	uint16_t RST;
+	int dma[LCD_TILED_SPI_COUNT];
+	bool invertText;
+	enum LCD_rotation rotation;
+	bool mirrorX;
+	bool mirrorY;
+};
+
+/*----- Library Functions -----*/
+
+void LCD_tiledInit(struct LCD_panel *panels, uint8_t columns, uint8_t rows, uint16_t RST, const struct LCD_config *config);
+void LCD_tiledInvertText(bool mode);
+void LCD_tiledSetOrientation(enum LCD_rotation rotation, bool mirrorX, bool mirrorY);
+uint16_t LCD_tiledWidth();
+uint16_t LCD_tiledHeight();
+
+/*----- Draw Functions -----*/
+/*
+ * These functions draw in panel buffers. It's necessary to use LCD_tiledRefresh()
+ * in order to send data to the panels.
+ */
+
+void LCD_tiledClrBuff();
+void LCD_tiledRefresh();
+void LCD_tiledSetPixel(int16_t x0, int16_t y0, bool mode);
+bool LCD_tiledGetPixel(int16_t x0, int16_t y0);
+void LCD_tiledDrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+void LCD_tiledDrawRectangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1);
+void LCD_tiledPutChar(char c, int16_t x0, int16_t y0);
+void LCD_tiledPrint(char *str, int16_t x0, int16_t y0);
+
+#endif
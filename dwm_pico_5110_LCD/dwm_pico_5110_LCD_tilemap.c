@@ -0,0 +1,194 @@
+/*
+ * File: dwm_pico_5110_LCD_tilemap.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#include "dwm_pico_5110_LCD_tilemap.h"
+
+extern struct LCD_att lcd;
+
+/**
+ * @brief Initialize a tilemap, whole screen is rendered on next LCD_tilemapRender().
+ *
+ * @param tilemap tilemap to initialize.
+ * @param tileset tiles, 8 bytes each.
+ * @param map     tile indexes, row by row, width * height entries.
+ * @param width   map width in tiles.
+ * @param height  map height in tiles.
+ */
+void LCD_tilemapInit(struct LCD_tilemap *tilemap, const uint8_t (*tileset)[LCD_TILE_SIZE], uint8_t *map, uint8_t width, uint8_t height)
+{
+  tilemap->tileset = tileset;
+  tilemap->map = map;
+  tilemap->width = width;
+  tilemap->height = height;
+  tilemap->scrollX = 0;
+  tilemap->scrollY = 0;
+
+  LCD_tilemapInvalidate(tilemap);
+}
+
+/**
+ * @brief Mark screen cells covering a map tile as dirty.
+ *
+ * @param tilemap tilemap.
+ * @param x       tile position on the x-axis (in tiles).
+ * @param y       tile position on the y-axis (in tiles).
+ */
+static void LCD_tilemapMarkTile(struct LCD_tilemap *tilemap, uint8_t x, uint8_t y)
+{
+  uint16_t mapWidth = tilemap->width * LCD_TILE_SIZE;
+  uint16_t mapHeight = tilemap->height * LCD_TILE_SIZE;
+  uint16_t left = (x * LCD_TILE_SIZE + mapWidth - tilemap->scrollX % mapWidth) % mapWidth;
+  uint16_t top = (y * LCD_TILE_SIZE + mapHeight - tilemap->scrollY % mapHeight) % mapHeight;
+
+  // Small maps repeat on the screen, unaligned scroll spreads a tile over 2x2 cells,
+  // tile may also stick out of screen edges
+  for (int16_t sy = top - mapHeight; sy < LCD_HEIGHT; sy += mapHeight)
+    for (int16_t sx = left - mapWidth; sx < LCD_WIDTH; sx += mapWidth)
+    {
+      int16_t x0 = sx < 0 ? 0 : sx;
+      int16_t y0 = sy < 0 ? 0 : sy;
+      int16_t x1 = sx + LCD_TILE_SIZE - 1 >= LCD_WIDTH ? LCD_WIDTH - 1 : sx + LCD_TILE_SIZE - 1;
+      int16_t y1 = sy + LCD_TILE_SIZE - 1 >= LCD_HEIGHT ? LCD_HEIGHT - 1 : sy + LCD_TILE_SIZE - 1;
+
+      if (x0 > x1 || y0 > y1)
+        continue;
+
+      for (int16_t row = y0 / LCD_TILE_SIZE; row <= y1 / LCD_TILE_SIZE; row++)
+        for (int16_t cell = x0 / LCD_TILE_SIZE; cell <= x1 / LCD_TILE_SIZE; cell++)
+          tilemap->dirty[row] |= 1 << cell;
+    }
+}
+
+/**
+ * @brief Change a tile of the map, marks cells showing it as dirty.
+ *
+ * @param tilemap tilemap.
+ * @param x       tile position on the x-axis (in tiles).
+ * @param y       tile position on the y-axis (in tiles).
+ * @param tile    index in the tileset.
+ */
+void LCD_tilemapSetTile(struct LCD_tilemap *tilemap, uint8_t x, uint8_t y, uint8_t tile)
+{
+  if (x >= tilemap->width || y >= tilemap->height || tilemap->map[y * tilemap->width + x] == tile)
+    return;
+
+  tilemap->map[y * tilemap->width + x] = tile;
+  LCD_tilemapMarkTile(tilemap, x, y);
+}
+
+/**
+ * @brief Get a tile of the map.
+ *
+ * @param tilemap tilemap.
+ * @param x       tile position on the x-axis (in tiles).
+ * @param y       tile position on the y-axis (in tiles).
+ * @return        index in the tileset.
+ */
+uint8_t LCD_tilemapGetTile(const struct LCD_tilemap *tilemap, uint8_t x, uint8_t y)
+{
+  return tilemap->map[(y % tilemap->height) * tilemap->width + x % tilemap->width];
+}
+
+/**
+ * @brief Set position of the screen on the map, in pixels.
+ *
+ * @param tilemap tilemap.
+ * @param x       position on the x-axis.
+ * @param y       position on the y-axis.
+ */
+void LCD_tilemapScroll(struct LCD_tilemap *tilemap, uint16_t x, uint16_t y)
+{
+  x %= tilemap->width * LCD_TILE_SIZE;
+  y %= tilemap->height * LCD_TILE_SIZE;
+
+  if (x == tilemap->scrollX && y == tilemap->scrollY)
+    return;
+
+  tilemap->scrollX = x;
+  tilemap->scrollY = y;
+  LCD_tilemapInvalidate(tilemap);
+}
+
+/**
+ * @brief Mark whole screen as dirty.
+ *
+ * @param tilemap tilemap.
+ */
+void LCD_tilemapInvalidate(struct LCD_tilemap *tilemap)
+{
+  for (uint8_t row = 0; row < LCD_ROW_NUMBER; row++)
+    tilemap->dirty[row] = (1 << LCD_TILEMAP_CELLS_IN_ROW) - 1;
+}
+
+/**
+ * @brief Render one screen cell into lcd.buffer (or current draw target).
+ *
+ * @param tilemap tilemap.
+ * @param cell    cell position on the x-axis (in cells).
+ * @param row     row number (multiple of 8 lines).
+ */
+static void LCD_tilemapRenderCell(const struct LCD_tilemap *tilemap, uint8_t cell, uint8_t row)
+{
+  uint16_t mapWidth = tilemap->width * LCD_TILE_SIZE;
+  uint16_t y = (row * LCD_TILE_SIZE + tilemap->scrollY) % (tilemap->height * LCD_TILE_SIZE);
+  uint8_t shift = y % LCD_TILE_SIZE;
+  const uint8_t *upper = &tilemap->map[(y / LCD_TILE_SIZE) * tilemap->width];
+  const uint8_t *lower = &tilemap->map[((y / LCD_TILE_SIZE + 1) % tilemap->height) * tilemap->width];
+  uint8_t *dst = &lcd.target[row * LCD_WIDTH];
+
+  lcd.targetDirty |= 1 << row;
+
+  for (uint8_t x = cell * LCD_TILE_SIZE; x < (cell + 1) * LCD_TILE_SIZE && x < LCD_WIDTH; x++)
+  {
+    uint16_t mapX = (x + tilemap->scrollX) % mapWidth;
+    uint8_t tile = mapX / LCD_TILE_SIZE;
+    uint8_t column = mapX % LCD_TILE_SIZE;
+
+    if (shift)
+      dst[x] = tilemap->tileset[upper[tile]][column] >> shift | tilemap->tileset[lower[tile]][column] << (LCD_TILE_SIZE - shift);
+    else
+      dst[x] = tilemap->tileset[upper[tile]][column];
+  }
+}
+
+/**
+ * @brief Render dirty cells into lcd.buffer and send them to the LCD.
+ *        Neighbouring dirty cells are sent together.
+ *
+ * @param tilemap tilemap.
+ */
+void LCD_tilemapRender(struct LCD_tilemap *tilemap)
+{
+  for (uint8_t row = 0; row < LCD_ROW_NUMBER; row++)
+  {
+    uint8_t cell = 0;
+
+    while (tilemap->dirty[row])
+    {
+      // Find run of dirty cells
+      while (!(tilemap->dirty[row] & 1 << cell))
+        cell++;
+
+      uint8_t first = cell;
+
+      while (tilemap->dirty[row] & 1 << cell)
+      {
+        LCD_tilemapRenderCell(tilemap, cell, row);
+        tilemap->dirty[row] &= ~(1 << cell);
+        cell++;
+      }
+
+      // Drawn in a layer, composing sends it
+      if (lcd.target == lcd.buffer)
+        LCD_refreshArea(first * LCD_TILE_SIZE, cell * LCD_TILE_SIZE, row, 1);
+    }
+  }
+}
@@ -0,0 +1,52 @@
+/*
+ * File: dwm_pico_5110_LCD_tilemap.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#ifndef DWM_PICO_5110_LCD_TILEMAP
+#define DWM_PICO_5110_LCD_TILEMAP
+
+#include "dwm_pico_5110_LCD.h"
+
+/*
+ * Tilemap of 8x8 tiles, matching LCD's 8 line rows.
+ * Tiles are 8 bytes in lcd.buffer layout (one byte per column, LSB on top), so a tileset
+ * can be kept in flash. The screen is split into cells of 8x8 pixels, only cells marked
+ * dirty are rendered and sent. With scroll offsets being multiple of 8, changing one
+ * tile sends 8 bytes.
+ * The map wraps around in both directions.
+ */
+
+#define LCD_TILE_SIZE 8
+#define LCD_TILEMAP_CELLS_IN_ROW ((LCD_WIDTH + LCD_TILE_SIZE - 1) / LCD_TILE_SIZE)
+
+/**
+ * @brief Tilemap parameters.
+ */
+struct LCD_tilemap
+{
+	const uint8_t (*tileset)[LCD_TILE_SIZE];
+	uint8_t *map;
+	uint8_t width;
+	uint8_t height;
+	uint16_t scrollX;
+	uint16_t scrollY;
+	uint16_t dirty[LCD_ROW_NUMBER];
+};
+
+/*----- Library Functions -----*/
+
+void LCD_tilemapInit(struct LCD_tilemap *tilemap, const uint8_t (*tileset)[LCD_TILE_SIZE], uint8_t *map, uint8_t width, uint8_t height);
+void LCD_tilemapSetTile(struct LCD_tilemap *tilemap, uint8_t x, uint8_t y, uint8_t tile);
+uint8_t LCD_tilemapGetTile(const struct LCD_tilemap *tilemap, uint8_t x, uint8_t y);
+void LCD_tilemapScroll(struct LCD_tilemap *tilemap, uint16_t x, uint16_t y);
+void LCD_tilemapInvalidate(struct LCD_tilemap *tilemap);
+void LCD_tilemapRender(struct LCD_tilemap *tilemap);
+
+#endif
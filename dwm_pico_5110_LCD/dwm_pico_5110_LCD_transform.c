@@ -0,0 +1,594 @@
+/*
+ * File: dwm_pico_5110_LCD_transform.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#include "dwm_pico_5110_LCD_transform.h"
+
+// Smallest and largest arc step, segments are about 4 pixels long in between
+#define LCD_ARC_STEP_MIN (LCD_ANGLE_FULL / 64)
+#define LCD_ARC_STEP_MAX (LCD_ANGLE_FULL / 16)
+#define LCD_ARC_MAX_POINTS (LCD_ANGLE_FULL / LCD_ARC_STEP_MIN + 1)
+
+// Tick length on gauge dial
+#define LCD_GAUGE_TICK 3
+
+// First quarter of sine wave, Q15, LCD_ANGLE_QUARTER + 1 entries
+static const int16_t sinTable[LCD_ANGLE_QUARTER + 1] = {
+      0,   201,   402,   603,   804,  1005,  1206,  1407,  1608,  1809,  2009,  2210,
+   2410,  2611,  2811,  3012,  3212,  3412,  3612,  3811,  4011,  4210,  4410,  4609,
+   4808,  5007,  5205,  5404,  5602,  5800,  5998,  6195,  6393,  6590,  6786,  6983,
+   7179,  7375,  7571,  7767,  7962,  8157,  8351,  8545,  8739,  8933,  9126,  9319,
+   9512,  9704,  9896, 10087, 10278, 10469, 10659, 10849, 11039, 11228, 11417, 11605,
+  11793, 11980, 12167, 12353, 12539, 12725, 12910, 13094, 13279, 13462, 13645, 13828,
+  14010, 14191, 14372, 14553, 14732, 14912, 15090, 15269, 15446, 15623, 15800, 15976,
+  16151, 16325, 16499, 16673, 16846, 17018, 17189, 17360, 17530, 17700, 17869, 18037,
+  18204, 18371, 18537, 18703, 18868, 19032, 19195, 19357, 19519, 19680, 19841, 20000,
+  20159, 20317, 20475, 20631, 20787, 20942, 21096, 21250, 21403, 21554, 21705, 21856,
+  22005, 22154, 22301, 22448, 22594, 22739, 22884, 23027, 23170, 23311, 23452, 23592,
+  23731, 23870, 24007, 24143, 24279, 24413, 24547, 24680, 24811, 24942, 25072, 25201,
+  25329, 25456, 25582, 25708, 25832, 25955, 26077, 26198, 26319, 26438, 26556, 26674,
+  26790, 26905, 27019, 27133, 27245, 27356, 27466, 27575, 27683, 27790, 27896, 28001,
+  28105, 28208, 28310, 28411, 28510, 28609, 28706, 28803, 28898, 28992, 29085, 29177,
+  29268, 29358, 29447, 29534, 29621, 29706, 29791, 29874, 29956, 30037, 30117, 30195,
+  30273, 30349, 30424, 30498, 30571, 30643, 30714, 30783, 30852, 30919, 30985, 31050,
+  31113, 31176, 31237, 31297, 31356, 31414, 31470, 31526, 31580, 31633, 31685, 31736,
+  31785, 31833, 31880, 31926, 31971, 32014, 32057, 32098, 32137, 32176, 32213, 32250,
+  32285, 32318, 32351, 32382, 32412, 32441, 32469, 32495, 32521, 32545, 32567, 32589,
+  32609, 32628, 32646, 32663, 32678, 32692, 32705, 32717, 32728, 32737, 32745, 32752,
+  32757, 32761, 32765, 32766, 32767
+};
+
+static struct LCD_matrix stack[LCD_TRANSFORM_STACK_DEPTH] = {{LCD_Q16_ONE, 0, 0, LCD_Q16_ONE, 0, 0}};
+static uint8_t depth;
+
+/*----- Trigonometry -----*/
+
+/**
+ * @brief Sine from lookup table.
+ *
+ * @param angle angle, LCD_ANGLE_FULL per turn.
+ *
+ * @return sine in Q15.
+ */
+int16_t LCD_sin(uint16_t angle)
+{
+  uint16_t i = angle % LCD_ANGLE_QUARTER;
+
+  switch (angle / LCD_ANGLE_QUARTER % 4)
+  {
+  case 0:
+    return sinTable[i];
+  case 1:
+    return sinTable[LCD_ANGLE_QUARTER - i];
+  case 2:
+    return -sinTable[i];
+  default:
+    return -sinTable[LCD_ANGLE_QUARTER - i];
+  }
+}
+
+/**
+ * @brief Cosine from lookup table.
+ *
+ * @param angle angle, LCD_ANGLE_FULL per turn.
+ *
+ * @return cosine in Q15.
+ */
+int16_t LCD_cos(uint16_t angle)
+{
+  return LCD_sin(angle + LCD_ANGLE_QUARTER);
+}
+
+/*----- Matrix stack -----*/
+
+/**
+ * @brief Reset current matrix to identity.
+ */
+void LCD_transformIdentity()
+{
+  struct LCD_matrix *m = &stack[depth];
+
+  m->a = m->d = LCD_Q16_ONE;
+  m->b = m->c = m->tx = m->ty = 0;
+}
+
+/**
+ * @brief Save current matrix, it's restored with LCD_transformPop().
+ *
+ * @return false if the stack is full.
+ */
+bool LCD_transformPush()
+{
+  if (depth + 1 >= LCD_TRANSFORM_STACK_DEPTH)
+    return false;
+
+  stack[depth + 1] = stack[depth];
+  depth++;
+
+  return true;
+}
+
+/**
+ * @brief Restore matrix saved with LCD_transformPush().
+ *
+ * @return false if the stack is empty.
+ */
+bool LCD_transformPop()
+{
+  if (!depth)
+    return false;
+
+  depth--;
+
+  return true;
+}
+
+/**
+ * @brief Multiply current matrix by given one, it's applied to shapes before current transform.
+ *
+ * @param matrix matrix.
+ */
+void LCD_transformMultiply(const struct LCD_matrix *matrix)
+{
+  struct LCD_matrix *m = &stack[depth];
+  struct LCD_matrix r;
+
+  r.a = ((int64_t)m->a * matrix->a + (int64_t)m->b * matrix->c) >> 16;
+  r.b = ((int64_t)m->a * matrix->b + (int64_t)m->b * matrix->d) >> 16;
+  r.c = ((int64_t)m->c * matrix->a + (int64_t)m->d * matrix->c) >> 16;
+  r.d = ((int64_t)m->c * matrix->b + (int64_t)m->d * matrix->d) >> 16;
+  r.tx = (((int64_t)m->a * matrix->tx + (int64_t)m->b * matrix->ty) >> 16) + m->tx;
+  r.ty = (((int64_t)m->c * matrix->tx + (int64_t)m->d * matrix->ty) >> 16) + m->ty;
+
+  *m = r;
+}
+
+/**
+ * @brief Move origin of the current transform.
+ *
+ * @param x offset on x axis.
+ * @param y offset on y axis.
+ */
+void LCD_transformTranslate(int16_t x, int16_t y)
+{
+  struct LCD_matrix t = {LCD_Q16_ONE, 0, 0, LCD_Q16_ONE, (int32_t)x * LCD_Q16_ONE, (int32_t)y * LCD_Q16_ONE};
+
+  LCD_transformMultiply(&t);
+}
+
+/**
+ * @brief Rotate current transform around its origin, clockwise.
+ *
+ * @param angle angle, LCD_ANGLE_FULL per turn.
+ */
+void LCD_transformRotate(uint16_t angle)
+{
+  int32_t c = (int32_t)LCD_cos(angle) * 2;
+  int32_t s = (int32_t)LCD_sin(angle) * 2;
+  struct LCD_matrix r = {c, -s, s, c, 0, 0};
+
+  LCD_transformMultiply(&r);
+}
+
+/**
+ * @brief Scale current transform.
+ *
+ * @param sx scale on x axis, Q16.16.
+ * @param sy scale on y axis, Q16.16.
+ */
+void LCD_transformScale(int32_t sx, int32_t sy)
+{
+  struct LCD_matrix s = {sx, 0, 0, sy, 0, 0};
+
+  LCD_transformMultiply(&s);
+}
+
+/**
+ * @brief Transform a point to screen coordinates.
+ *
+ * @param point point in model coordinates.
+ *
+ * @return point in screen coordinates, rounded.
+ */
+struct LCD_point LCD_transformPoint(struct LCD_point point)
+{
+  const struct LCD_matrix *m = &stack[depth];
+  struct LCD_point r;
+
+  // Q16 products of full range points don't fit in 32 bits
+  r.x = ((int64_t)m->a * point.x + (int64_t)m->b * point.y + m->tx + LCD_Q16_ONE / 2) >> 16;
+  r.y = ((int64_t)m->c * point.x + (int64_t)m->d * point.y + m->ty + LCD_Q16_ONE / 2) >> 16;
+
+  return r;
+}
+
+/*----- Vector shapes -----*/
+
+/**
+ * @brief Cohen-Sutherland region code of a point.
+ */
+static uint8_t LCD_vectorOutcode(int32_t x, int32_t y)
+{
+  uint8_t code = 0;
+
+  if (x < 0)
+    code |= 1;
+  else if (x >= LCD_WIDTH)
+    code |= 2;
+  if (y < 0)
+    code |= 4;
+  else if (y >= LCD_HEIGHT)
+    code |= 8;
+
+  return code;
+}
+
+/**
+ * @brief Draw a line in screen coordinates, clipped to the screen.
+ */
+static void LCD_vectorScreenLine(struct LCD_point a, struct LCD_point b, enum LCD_drawMode mode)
+{
+  int32_t x0 = a.x, y0 = a.y, x1 = b.x, y1 = b.y;
+
+  while (true)
+  {
+    uint8_t code0 = LCD_vectorOutcode(x0, y0);
+    uint8_t code1 = LCD_vectorOutcode(x1, y1);
+    uint8_t code = code0 ? code0 : code1;
+    int32_t x, y;
+
+    if (!(code0 | code1))
+      break;
+    if (code0 & code1)
+      return;
+
+    // Move the outside end to the edge it crosses, deltas of int16 points multiply past 32 bits
+    if (code & 8)
+    {
+      y = LCD_HEIGHT - 1;
+      x = x0 + (int64_t)(x1 - x0) * (y - y0) / (y1 - y0);
+    }
+    else if (code & 4)
+    {
+      y = 0;
+      x = x0 + (int64_t)(x1 - x0) * (y - y0) / (y1 - y0);
+    }
+    else if (code & 2)
+    {
+      x = LCD_WIDTH - 1;
+      y = y0 + (int64_t)(y1 - y0) * (x - x0) / (x1 - x0);
+    }
+    else
+    {
+      x = 0;
+      y = y0 + (int64_t)(y1 - y0) * (x - x0) / (x1 - x0);
+    }
+
+    if (code == code0)
+    {
+      x0 = x;
+      y0 = y;
+    }
+    else
+    {
+      x1 = x;
+      y1 = y;
+    }
+  }
+
+  LCD_drawLineOp(x0, y0, x1, y1, mode);
+}
+
+/**
+ * @brief Toggle a pixel given in screen coordinates, if it's on the screen.
+ */
+static void LCD_vectorTogglePixel(struct LCD_point p)
+{
+  if (p.x >= 0 && p.x < LCD_WIDTH && p.y >= 0 && p.y < LCD_HEIGHT)
+    LCD_drawLineOp(p.x, p.y, p.x, p.y, LCD_DRAW_XOR);
+}
+
+/**
+ * @brief Draws a line through the current transform.
+ *
+ * @param a     starting point.
+ * @param b     ending point.
+ * @param mode  set / clear / xor.
+ */
+void LCD_vectorLine(struct LCD_point a, struct LCD_point b, enum LCD_drawMode mode)
+{
+  LCD_vectorScreenLine(LCD_transformPoint(a), LCD_transformPoint(b), mode);
+}
+
+/**
+ * @brief Draws connected lines through the current transform.
+ *        In xor mode joints are drawn once, so drawing the polyline again erases it.
+ *
+ * @param points  vertices.
+ * @param count   number of vertices.
+ * @param closed  true = last vertex is connected to the first one.
+ * @param mode    set / clear / xor.
+ */
+void LCD_vectorPolyline(const struct LCD_point *points, uint8_t count, bool closed, enum LCD_drawMode mode)
+{
+  struct LCD_point first, prev;
+  uint8_t segments = 0;
+
+  if (!count)
+    return;
+
+  first = prev = LCD_transformPoint(points[0]);
+
+  for (uint16_t i = 1; i < count + closed; i++)
+  {
+    struct LCD_point p = i < count ? LCD_transformPoint(points[i]) : first;
+
+    if (p.x == prev.x && p.y == prev.y)
+      continue;
+
+    // Joint was toggled by the previous segment and would be toggled back by this one
+    if (segments && mode == LCD_DRAW_XOR)
+      LCD_vectorTogglePixel(prev);
+
+    LCD_vectorScreenLine(prev, p, mode);
+    segments++;
+    prev = p;
+  }
+
+  if (closed && segments > 1 && mode == LCD_DRAW_XOR)
+    LCD_vectorTogglePixel(first);
+}
+
+/**
+ * @brief Point on a circle, in model coordinates.
+ */
+static struct LCD_point LCD_vectorPolar(struct LCD_point center, int16_t radius, uint16_t angle)
+{
+  struct LCD_point p;
+
+  p.x = center.x + (((int32_t)radius * LCD_cos(angle) + LCD_Q15_ONE / 2) >> 15);
+  p.y = center.y + (((int32_t)radius * LCD_sin(angle) + LCD_Q15_ONE / 2) >> 15);
+
+  return p;
+}
+
+/**
+ * @brief Draws an arc through the current transform, as a polyline of about 4 pixel long segments.
+ *
+ * @param center  center of the arc.
+ * @param radius  radius.
+ * @param start   starting angle.
+ * @param sweep   angle covered clockwise, LCD_ANGLE_FULL = circle.
+ * @param mode    set / clear / xor.
+ */
+void LCD_vectorArc(struct LCD_point center, int16_t radius, uint16_t start, uint16_t sweep, enum LCD_drawMode mode)
+{
+  struct LCD_point points[LCD_ARC_MAX_POINTS];
+  uint16_t step = radius > 0 ? 652 / radius : LCD_ARC_STEP_MAX; // 4 pixels: LCD_ANGLE_FULL * 4 / (2 * pi * radius)
+  uint8_t count = 0;
+  bool closed = sweep >= LCD_ANGLE_FULL;
+
+  if (step < LCD_ARC_STEP_MIN)
+    step = LCD_ARC_STEP_MIN;
+  if (step > LCD_ARC_STEP_MAX)
+    step = LCD_ARC_STEP_MAX;
+  if (closed)
+    sweep = LCD_ANGLE_FULL;
+
+  for (uint16_t angle = 0; angle < sweep; angle += step)
+    points[count++] = LCD_vectorPolar(center, radius, start + angle);
+
+  if (!closed)
+    points[count++] = LCD_vectorPolar(center, radius, start + sweep);
+
+  LCD_vectorPolyline(points, count, closed, mode);
+}
+
+/**
+ * @brief Polygon edge crossing columns x0 .. x1 - 1, y of the crossing at the column center is
+ *        y + rem / den in Q8, stepped by step + stepRem / den per column.
+ */
+struct LCD_polygonEdge
+{
+  int16_t x0;
+  int16_t x1;
+  int32_t y;
+  int32_t rem;
+  int32_t step;
+  int32_t stepRem;
+  int32_t den;
+};
+
+/**
+ * @brief Set up an edge, starting at the first column drawn.
+ *
+ * @param edge  edge to set up.
+ * @param a     vertex.
+ * @param b     other vertex, on another column.
+ * @param left  first column drawn.
+ */
+static void LCD_polygonEdgeInit(struct LCD_polygonEdge *edge, struct LCD_point a, struct LCD_point b, int16_t left)
+{
+  if (a.x > b.x)
+  {
+    struct LCD_point tmp = a;
+    a = b;
+    b = tmp;
+  }
+
+  int32_t dy = b.y - a.y;
+
+  edge->x0 = a.x < left ? left : a.x;
+  edge->x1 = b.x;
+  edge->den = 2 * (b.x - a.x);
+
+  // y = a.y + (2 * (x - a.x) + 1) * dy / den, the only division of the edge is done here
+  int64_t offset = (int64_t)(2 * (edge->x0 - a.x) + 1) * dy * 256;
+  int64_t y = offset / edge->den;
+
+  edge->rem = offset % edge->den;
+  if (edge->rem < 0)
+  {
+    edge->rem += edge->den;
+    y--;
+  }
+  edge->y = a.y * 256 + y;
+
+  edge->step = dy * 512 / edge->den;
+  edge->stepRem = dy * 512 % edge->den;
+  if (edge->stepRem < 0)
+  {
+    edge->stepRem += edge->den;
+    edge->step--;
+  }
+}
+
+/**
+ * @brief Draws a filled polygon through the current transform.
+ *        Pixels with centers inside the polygon (even-odd rule) are drawn, column by column,
+ *        so every column is a single vertical run written a byte at a time.
+ *        Edge crossings are stepped from column to column, no division per column.
+ *
+ * @param points  vertices, up to LCD_POLYGON_MAX_POINTS.
+ * @param count   number of vertices.
+ * @param mode    set / clear / xor.
+ */
+void LCD_vectorFillPolygon(const struct LCD_point *points, uint8_t count, enum LCD_drawMode mode)
+{
+  struct LCD_point p[LCD_POLYGON_MAX_POINTS];
+  struct LCD_polygonEdge edges[LCD_POLYGON_MAX_POINTS];
+  int32_t crossings[LCD_POLYGON_MAX_POINTS];
+  int16_t left = INT16_MAX, right = INT16_MIN;
+  uint8_t nEdge = 0;
+
+  if (count > LCD_POLYGON_MAX_POINTS)
+    count = LCD_POLYGON_MAX_POINTS;
+  if (count < 3)
+    return;
+
+  for (uint8_t i = 0; i < count; i++)
+  {
+    p[i] = LCD_transformPoint(points[i]);
+    if (p[i].x < left)
+      left = p[i].x;
+    if (p[i].x > right)
+      right = p[i].x;
+  }
+
+  if (left < 0)
+    left = 0;
+  if (right > LCD_WIDTH)
+    right = LCD_WIDTH;
+
+  // Vertical edges cross no column center
+  for (uint8_t i = 0, j = count - 1; i < count; j = i++)
+    if (p[i].x != p[j].x)
+      LCD_polygonEdgeInit(&edges[nEdge++], p[i], p[j], left);
+
+  for (int16_t x = left; x < right; x++)
+  {
+    uint8_t n = 0;
+
+    // Edges crossing the column center, y in Q8
+    for (uint8_t i = 0; i < nEdge; i++)
+    {
+      struct LCD_polygonEdge *edge = &edges[i];
+
+      if (x < edge->x0 || x >= edge->x1)
+        continue;
+
+      int32_t y = edge->y;
+
+      edge->y += edge->step;
+      edge->rem += edge->stepRem;
+      if (edge->rem >= edge->den)
+      {
+        edge->rem -= edge->den;
+        edge->y++;
+      }
+
+      // Insertion sort, there are only a few crossings
+      uint8_t k = n++;
+      for (; k > 0 && crossings[k - 1] > y; k--)
+        crossings[k] = crossings[k - 1];
+      crossings[k] = y;
+    }
+
+    for (uint8_t i = 0; i + 1 < n; i += 2)
+    {
+      // Pixel centers within the span: ceil(y - 0.5)
+      int32_t top = -((128 - crossings[i]) >> 8);
+      int32_t bottom = -((128 - crossings[i + 1]) >> 8) - 1;
+
+      if (top < 0)
+        top = 0;
+      if (bottom >= LCD_HEIGHT)
+        bottom = LCD_HEIGHT - 1;
+      if (top <= bottom)
+        LCD_drawLineOp(x, top, x, bottom, mode);
+    }
+  }
+}
+
+/*----- Gauge -----*/
+
+/**
+ * @brief Angle of a gauge value.
+ */
+static uint16_t LCD_gaugeAngle(const struct LCD_gauge *gauge, int16_t value)
+{
+  if (gauge->max == gauge->min)
+    return gauge->start;
+
+  if (value < gauge->min)
+    value = gauge->min;
+  if (value > gauge->max)
+    value = gauge->max;
+
+  return gauge->start + (int32_t)(value - gauge->min) * gauge->sweep / (gauge->max - gauge->min);
+}
+
+/**
+ * @brief Draws gauge's scale: arc and ticks, through the current transform.
+ *
+ * @param gauge gauge.
+ */
+void LCD_gaugeDrawDial(const struct LCD_gauge *gauge)
+{
+  struct LCD_point center = {gauge->x, gauge->y};
+
+  LCD_vectorArc(center, gauge->radius, gauge->start, gauge->sweep, LCD_DRAW_SET);
+
+  for (uint8_t i = 0; i < gauge->ticks; i++)
+  {
+    uint16_t angle = gauge->start + (gauge->ticks > 1 ? (uint32_t)gauge->sweep * i / (gauge->ticks - 1) : 0);
+
+    LCD_vectorLine(LCD_vectorPolar(center, gauge->radius - LCD_GAUGE_TICK, angle),
+                   LCD_vectorPolar(center, gauge->radius, angle), LCD_DRAW_SET);
+  }
+}
+
+/**
+ * @brief Draws gauge's needle, through the current transform.
+ *        Needle drawn in xor mode is erased by drawing it again with the same value.
+ *
+ * @param gauge gauge.
+ * @param value value to point at, clamped to gauge's range.
+ * @param mode  set / clear / xor.
+ */
+void LCD_gaugeDrawNeedle(const struct LCD_gauge *gauge, int16_t value, enum LCD_drawMode mode)
+{
+  struct LCD_point center = {gauge->x, gauge->y};
+  uint16_t angle = LCD_gaugeAngle(gauge, value);
+
+  // Short tail behind the center, tip clear of the ticks
+  LCD_vectorLine(LCD_vectorPolar(center, -(gauge->radius / 5), angle),
+                 LCD_vectorPolar(center, gauge->radius - LCD_GAUGE_TICK - 1, angle), mode);
+}
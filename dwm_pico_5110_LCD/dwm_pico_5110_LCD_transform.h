@@ -0,0 +1,101 @@
+/*
+ * File: dwm_pico_5110_LCD_transform.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+#ifndef DWM_PICO_5110_LCD_TRANSFORM
+#define DWM_PICO_5110_LCD_TRANSFORM
+
+#include "dwm_pico_5110_LCD.h"
+
+/*
+ * Fixed-point 2D transforms and vector shapes, no floating point is used.
+ *
+ * Angles are in binary units, LCD_ANGLE_FULL per turn, 0 points right and angles grow
+ * clockwise (y axis points down). Sine and cosine are Q15 (LCD_Q15_ONE = 1.0), matrix
+ * elements are Q16.16 (LCD_Q16_ONE = 1.0).
+ * Shapes are given in model coordinates, transformed by the current matrix and clipped
+ * to the screen, transformed points should stay within int16_t range.
+ */
+
+#define LCD_ANGLE_FULL 1024
+#define LCD_ANGLE_QUARTER (LCD_ANGLE_FULL / 4)
+#define LCD_Q15_ONE 32767
+#define LCD_Q16_ONE 65536
+
+#define LCD_TRANSFORM_STACK_DEPTH 8
+#define LCD_POLYGON_MAX_POINTS 16
+
+/**
+ * @brief Point in model or screen coordinates.
+ */
+struct LCD_point
+{
+	int16_t x;
+	int16_t y;
+};
+
+/**
+ * @brief Affine matrix, x' = a * x + b * y + tx, y' = c * x + d * y + ty (Q16.16).
+ */
+struct LCD_matrix
+{
+	int32_t a, b;
+	int32_t c, d;
+	int32_t tx, ty;
+};
+
+/**
+ * @brief Round gauge, value min is drawn at angle start, value max at start + sweep.
+ */
+struct LCD_gauge
+{
+	int16_t x;
+	int16_t y;
+	uint8_t radius;
+	uint16_t start;
+	uint16_t sweep;
+	int16_t min;
+	int16_t max;
+	uint8_t ticks;
+};
+
+/*----- Trigonometry -----*/
+
+int16_t LCD_sin(uint16_t angle);
+int16_t LCD_cos(uint16_t angle);
+
+/*----- Matrix stack -----*/
+
+void LCD_transformIdentity();
+bool LCD_transformPush();
+bool LCD_transformPop();
+void LCD_transformMultiply(const struct LCD_matrix *matrix);
+void LCD_transformTranslate(int16_t x, int16_t y);
+void LCD_transformRotate(uint16_t angle);
+void LCD_transformScale(int32_t sx, int32_t sy);
+struct LCD_point LCD_transformPoint(struct LCD_point point);
+
+/*----- Vector shapes -----*/
+/*
+ * These functions draw in lcd.buffer (or current draw target). It's necessary to use
+ * LCD_refreshScr() or LCD_refreshArea() in order to send data to the LCD.
+ */
+
+void LCD_vectorLine(struct LCD_point a, struct LCD_point b, enum LCD_drawMode mode);
+void LCD_vectorPolyline(const struct LCD_point *points, uint8_t count, bool closed, enum LCD_drawMode mode);
+void LCD_vectorArc(struct LCD_point center, int16_t radius, uint16_t start, uint16_t sweep, enum LCD_drawMode mode);
+void LCD_vectorFillPolygon(const struct LCD_point *points, uint8_t count, enum LCD_drawMode mode);
+
+/*----- Gauge -----*/
+
+void LCD_gaugeDrawDial(const struct LCD_gauge *gauge);
+void LCD_gaugeDrawNeedle(const struct LCD_gauge *gauge, int16_t value, enum LCD_drawMode mode);
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ * File: hpp_host_test.cpp
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+/*
+ * Host test of dwm_pico_5110_LCD.hpp, the driver runs on HostBus and
+ * the emulated controller memory is compared with the buffer.
+ */
+
+#include <cstdio>
+
+#include "dwm_pico_5110_LCD/dwm_pico_5110_LCD.hpp"
+
+#define CHECK(condition)                                                 \
+  do                                                                     \
+  {                                                                      \
+    if (!(condition))                                                    \
+    {                                                                    \
+      std::printf("%s:%d: %s failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                        \
+    }                                                                    \
+  } while (0)
+
+static int failures = 0;
+
+using Lcd = dwm::Pcd8544<dwm::HostBus<>>;
+using WideBus = dwm::HostBus<102, 8>;
+using WideLcd = dwm::Pcd8544<WideBus, 96, 64>;
+
+static_assert(Lcd::size == 504);
+static_assert(Lcd::index(83, 47) == 503);
+static_assert(WideLcd::size == 96 * 8);
+static_assert(dwm::fontInverted[0][0] == 0xFF);
+
+/**
+ * @brief Panel memory must hold the buffer after refresh.
+ */
+template <class Driver, class Bus>
+static bool ramMatches(Driver &lcd, const Bus &bus, uint8_t columns)
+{
+  for (uint8_t row = 0; row < Driver::banks; row++)
+    for (uint8_t x = 0; x < Driver::width; x++)
+      if (bus.ram[row * columns + x] != lcd.buffer()[row * Driver::width + x])
+        return false;
+
+  return true;
+}
+
+static void testDefaultPanel()
+{
+  Lcd lcd{dwm::HostBus<>()};
+
+  lcd.init();
+  lcd.drawLine(0, 0, 83, 47);
+  lcd.drawCircle(40, 20, 30);
+  lcd.refresh();
+
+  CHECK(lcd.bus().ram == lcd.buffer());
+  CHECK(lcd.getPixel(0, 0));
+  CHECK(lcd.getPixel(83, 47));
+
+  // Off-panel pixels are ignored and read back dim
+  lcd.setPixel(200, 200, true);
+  CHECK(!lcd.getPixel(200, 200));
+  CHECK(!lcd.getPixel(84, 0));
+  CHECK(!lcd.getPixel(0, 48));
+
+  // Partial refresh sends only the area
+  lcd.clrBuff();
+  lcd.refresh();
+  lcd.setPixel(10, 10, true);
+  size_t bytes = lcd.bus().bytes;
+  lcd.refreshArea(8, 12, 1, 1);
+  CHECK(lcd.bus().ram == lcd.buffer());
+  CHECK(lcd.bus().bytes - bytes == 4 + 2);
+
+  // Empty or off-panel areas send nothing
+  bytes = lcd.bus().bytes;
+  lcd.refreshArea(10, 5, 0, 1);
+  lcd.refreshArea(90, 100, 0, 1);
+  lcd.refreshArea(0, 84, 6, 2);
+  lcd.refreshArea(0, 84, 200, 100);
+  CHECK(lcd.bus().bytes == bytes);
+
+  // Rows past the panel are clamped
+  lcd.setPixel(0, 47, false);
+  lcd.setPixel(5, 44, true);
+  lcd.refreshArea(0, 84, 5, 10);
+  CHECK(lcd.bus().ram == lcd.buffer());
+}
+
+static void testWidePanel()
+{
+  WideLcd lcd{WideBus()};
+
+  lcd.init();
+  lcd.drawRectangle(0, 0, 95, 63);
+  lcd.drawLine(0, 63, 95, 0);
+  lcd.refresh();
+
+  CHECK(ramMatches(lcd, lcd.bus(), 102));
+  CHECK(lcd.getPixel(95, 63));
+  CHECK(!lcd.getPixel(96, 0));
+
+  lcd.setPixel(50, 30, true);
+  lcd.refreshArea(40, 60, 3, 1);
+  CHECK(ramMatches(lcd, lcd.bus(), 102));
+
+  // Columns past the panel stay untouched in controller's memory
+  for (uint8_t row = 0; row < WideLcd::banks; row++)
+    for (uint8_t x = WideLcd::width; x < 102; x++)
+      CHECK(lcd.bus().ram[row * 102 + x] == 0);
+}
+
+int main()
+{
+  testDefaultPanel();
+  testWidePanel();
+
+  std::printf("%s\n", failures ? "FAILED" : "OK");
+  return failures ? 1 : 0;
+}
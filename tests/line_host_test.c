@@ -0,0 +1,267 @@
+/*
+ * File: line_host_test.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+/*
+ * Host test of LCD_drawLineOp() and LCD_canvasDrawLine(), built against the SDK stand-in in sdk_stub
+ * with LCD_ENABLE_STATS. Run-slice lines are compared with Bresenham stepped one pixel at a time,
+ * on the screen points past the edge are moved to the edge and pixels of one byte in a row
+ * are combined in one mask, on a canvas they are skipped.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "dwm_pico_5110_LCD/dwm_pico_5110_LCD.h"
+#include "dwm_pico_5110_LCD/dwm_pico_5110_LCD_canvas.h"
+
+#define CHECK(condition)                                             \
+  do                                                                 \
+  {                                                                  \
+    if (!(condition))                                                \
+    {                                                                \
+      printf("%s:%d: %s failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                    \
+    }                                                                \
+  } while (0)
+
+#define RANDOM_LINES 200000
+#define CANVAS_WIDTH 120
+#define CANVAS_HEIGHT 60
+#define CANVAS_LINES 20000
+
+extern struct LCD_att lcd;
+
+static int failures = 0;
+static uint8_t expected[LCD_SIZE];
+static uint8_t canvasBuffer[LCD_CANVAS_SIZE(CANVAS_WIDTH, CANVAS_HEIGHT)];
+static uint8_t canvasExpected[LCD_CANVAS_SIZE(CANVAS_WIDTH, CANVAS_HEIGHT)];
+
+/**
+ * @brief Deterministic pseudo random numbers, same sequence on every host.
+ */
+static uint32_t randomNext()
+{
+  static uint32_t state = 2023;
+
+  state = state * 1103515245 + 12345;
+
+  return state >> 8;
+}
+
+/**
+ * @brief Apply a mask to expected.
+ */
+static void referenceMask(uint16_t index, uint8_t mask, enum LCD_drawMode mode)
+{
+  if (mode == LCD_DRAW_SET)
+    expected[index] |= mask;
+  else if (mode == LCD_DRAW_CLEAR)
+    expected[index] &= ~mask;
+  else
+    expected[index] ^= mask;
+}
+
+/**
+ * @brief Reference line, Bresenham one pixel at a time.
+ *
+ * @return number of pixels stepped.
+ */
+static uint16_t referenceLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1, enum LCD_drawMode mode)
+{
+  int16_t dx = abs(x1 - x0), dy = abs(y1 - y0);
+  int16_t sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+  int16_t err = dx - dy;
+  int32_t index = -1;
+  uint8_t mask = 0;
+  uint16_t pixels = 0;
+
+  while (true)
+  {
+    int16_t x = x0 < LCD_WIDTH ? x0 : LCD_WIDTH - 1;
+    int16_t y = y0 < LCD_HEIGHT ? y0 : LCD_HEIGHT - 1;
+    int32_t pixelIndex = (y / LCD_COLUMN_HEIGHT) * LCD_WIDTH + x;
+
+    if (pixelIndex != index)
+    {
+      if (mask)
+        referenceMask(index, mask, mode);
+      index = pixelIndex;
+      mask = 0;
+    }
+    mask |= 1 << (y % LCD_COLUMN_HEIGHT);
+    pixels++;
+
+    if (x0 == x1 && y0 == y1)
+      break;
+
+    int16_t e2 = 2 * err;
+    if (e2 > -dy)
+    {
+      err -= dy;
+      x0 += sx;
+    }
+    if (e2 < dx)
+    {
+      err += dx;
+      y0 += sy;
+    }
+  }
+
+  referenceMask(index, mask, mode);
+
+  return pixels;
+}
+
+/**
+ * @brief Draw a line on a random frame both ways and compare.
+ */
+static bool compareLine(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, enum LCD_drawMode mode)
+{
+  for (uint16_t i = 0; i < LCD_SIZE; i++)
+    expected[i] = lcd.buffer[i] = randomNext();
+
+  uint32_t pixels = LCD_getStats()->pixels[LCD_PRIMITIVE_LINE];
+
+  uint16_t stepped = referenceLine(x0, y0, x1, y1, mode);
+  LCD_drawLineOp(x0, y0, x1, y1, mode);
+
+  return !memcmp(expected, lcd.buffer, LCD_SIZE) && LCD_getStats()->pixels[LCD_PRIMITIVE_LINE] - pixels == stepped;
+}
+
+static void testOnPanel()
+{
+  uint32_t mismatches = 0;
+
+  // Every slope from a few starting points, runs of all lengths along both axes
+  for (uint8_t x0 = 0; x0 < LCD_WIDTH; x0 += 13)
+    for (uint8_t y0 = 0; y0 < LCD_HEIGHT; y0 += 11)
+      for (uint8_t x1 = 0; x1 < LCD_WIDTH; x1++)
+        for (uint8_t y1 = 0; y1 < LCD_HEIGHT; y1++)
+          mismatches += !compareLine(x0, y0, x1, y1, (enum LCD_drawMode)((x1 + y1) % 3));
+
+  CHECK(mismatches == 0);
+}
+
+static void testRandom()
+{
+  uint32_t mismatches = 0;
+
+  // Ends past the screen edge as well, up to the full uint8_t range
+  for (uint32_t i = 0; i < RANDOM_LINES; i++)
+  {
+    uint16_t range = i % 3 == 0 ? 256 : i % 3 == 1 ? 100 : 20;
+    uint8_t x0 = randomNext() % range, y0 = randomNext() % range;
+    uint8_t x1 = randomNext() % range, y1 = randomNext() % range;
+
+    mismatches += !compareLine(x0, y0, x1, y1, (enum LCD_drawMode)(i % 3));
+  }
+
+  CHECK(mismatches == 0);
+}
+
+static void testClampToEdge()
+{
+  uint8_t before[LCD_SIZE];
+
+  // Points past the edge land on the edge pixel, xor toggles it once
+  LCD_clrBuff();
+  LCD_drawLineOp(80, 10, 200, 10, LCD_DRAW_XOR);
+  CHECK(LCD_getPixel(LCD_WIDTH - 1, 10));
+  CHECK(LCD_getPixel(80, 10) && LCD_getPixel(82, 10));
+
+  LCD_clrBuff();
+  LCD_drawLineOp(10, 40, 10, 250, LCD_DRAW_XOR);
+  CHECK(LCD_getPixel(10, LCD_HEIGHT - 1));
+  CHECK(LCD_getPixel(10, 40) && !LCD_getPixel(10, 39));
+
+  LCD_clrBuff();
+  LCD_drawLineOp(200, 100, 250, 200, LCD_DRAW_XOR);
+  CHECK(LCD_getPixel(LCD_WIDTH - 1, LCD_HEIGHT - 1));
+
+  // Same line twice in xor mode restores the frame
+  for (uint16_t i = 0; i < LCD_SIZE; i++)
+    lcd.buffer[i] = randomNext();
+  memcpy(before, lcd.buffer, LCD_SIZE);
+  LCD_drawLineOp(3, 250, 150, 2, LCD_DRAW_XOR);
+  LCD_drawLineOp(3, 250, 150, 2, LCD_DRAW_XOR);
+  CHECK(!memcmp(before, lcd.buffer, LCD_SIZE));
+}
+
+/**
+ * @brief Reference canvas line, Bresenham one pixel at a time, pixels outside the canvas skipped.
+ */
+static void referenceCanvasLine(int32_t x0, int32_t y0, int32_t x1, int32_t y1)
+{
+  int32_t dx = abs(x1 - x0), dy = abs(y1 - y0);
+  int32_t sx = x0 < x1 ? 1 : -1, sy = y0 < y1 ? 1 : -1;
+  int32_t err = dx - dy;
+
+  while (true)
+  {
+    if (x0 >= 0 && y0 >= 0 && x0 < CANVAS_WIDTH && y0 < CANVAS_HEIGHT)
+      canvasExpected[(y0 / LCD_COLUMN_HEIGHT) * CANVAS_WIDTH + x0] |= 1 << (y0 % LCD_COLUMN_HEIGHT);
+
+    if (x0 == x1 && y0 == y1)
+      break;
+
+    int32_t e2 = 2 * err;
+    if (e2 > -dy)
+    {
+      err -= dy;
+      x0 += sx;
+    }
+    if (e2 < dx)
+    {
+      err += dx;
+      y0 += sy;
+    }
+  }
+}
+
+static void testCanvas()
+{
+  struct LCD_canvas canvas;
+  uint32_t mismatches = 0;
+
+  LCD_canvasInit(&canvas, canvasBuffer, CANVAS_WIDTH, CANVAS_HEIGHT);
+
+  // Ends far outside as well, deltas past the int16_t range
+  for (uint32_t i = 0; i < CANVAS_LINES; i++)
+  {
+    int32_t range = i % 100 ? 400 : 65536;
+    int16_t x0 = (int32_t)(randomNext() % range) - range / 2, y0 = (int32_t)(randomNext() % range) - range / 2;
+    int16_t x1 = (int32_t)(randomNext() % range) - range / 2, y1 = (int32_t)(randomNext() % range) - range / 2;
+
+    memset(canvasExpected, 0, sizeof(canvasExpected));
+    LCD_canvasClear(&canvas);
+    referenceCanvasLine(x0, y0, x1, y1);
+    LCD_canvasDrawLine(&canvas, x0, y0, x1, y1);
+    mismatches += memcmp(canvasExpected, canvasBuffer, sizeof(canvasBuffer)) != 0;
+  }
+
+  CHECK(mismatches == 0);
+}
+
+int main()
+{
+  testOnPanel();
+  testRandom();
+  testClampToEdge();
+  testCanvas();
+
+  if (failures)
+    printf("%d check(s) failed\n", failures);
+  else
+    printf("all checks passed\n");
+
+  return failures != 0;
+}
@@ -0,0 +1,47 @@
+/*
+ * File: gpio.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+/*
+ * Pico SDK stand-in for host tests, pins do nothing.
+ */
+
+#ifndef SDK_STUB_HARDWARE_GPIO
+#define SDK_STUB_HARDWARE_GPIO
+
+#include "pico/stdlib.h"
+
+#define GPIO_OUT 1
+#define GPIO_FUNC_SPI 1
+
+static inline void gpio_init(uint gpio)
+{
+  (void)gpio;
+}
+
+static inline void gpio_set_dir(uint gpio, bool out)
+{
+  (void)gpio;
+  (void)out;
+}
+
+static inline void gpio_put(uint gpio, bool value)
+{
+  (void)gpio;
+  (void)value;
+}
+
+static inline void gpio_set_function(uint gpio, uint fn)
+{
+  (void)gpio;
+  (void)fn;
+}
+
+#endif
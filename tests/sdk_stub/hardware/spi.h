@@ -0,0 +1,38 @@
+/*
+ * File: spi.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+/*
+ * Pico SDK stand-in for host tests, SPI transfers go nowhere.
+ */
+
+#ifndef SDK_STUB_HARDWARE_SPI
+#define SDK_STUB_HARDWARE_SPI
+
+#include "pico/stdlib.h"
+
+typedef struct spi_inst spi_inst_t;
+
+static inline int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len)
+{
+  (void)spi;
+  (void)src;
+
+  return (int)len;
+}
+
+static inline uint spi_get_baudrate(const spi_inst_t *spi)
+{
+  (void)spi;
+
+  return 4000000;
+}
+
+#endif
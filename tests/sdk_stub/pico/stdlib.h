@@ -0,0 +1,43 @@
+/*
+ * File: stdlib.h
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+/*
+ * Pico SDK stand-in for host tests, only what the library uses.
+ * Single core, time advances by 1 us on every read.
+ */
+
+#ifndef SDK_STUB_PICO_STDLIB
+#define SDK_STUB_PICO_STDLIB
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+static inline uint32_t time_us_32()
+{
+  static uint32_t now;
+
+  return now++;
+}
+
+static inline void sleep_us(uint64_t us)
+{
+  (void)us;
+}
+
+static inline uint get_core_num()
+{
+  return 0;
+}
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * File: transform_host_test.c
+ * Project: dwm_pico_5110_lcd
+ * -----
+ * This source code is released under GPLv3 license.
+ * Check LICENSE file for license agreement,
+ * copyrights, 3rd party licenses and changes info can be found in COPYING file.
+ * -----
+ * Copyright 2023 - 2023 M.Kusiak (timax)
+ */
+
+/*
+ * Host test of dwm_pico_5110_LCD_transform, built against the SDK stand-in in sdk_stub.
+ * Filled polygons are compared with a reference computing every crossing exactly.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "dwm_pico_5110_LCD/dwm_pico_5110_LCD_transform.h"
+
+#define CHECK(condition)                                             \
+  do                                                                 \
+  {                                                                  \
+    if (!(condition))                                                \
+    {                                                                \
+      printf("%s:%d: %s failed\n", __FILE__, __LINE__, #condition); \
+      failures++;                                                    \
+    }                                                                \
+  } while (0)
+
+#define POLYGONS 20000
+
+extern struct LCD_att lcd;
+
+static int failures = 0;
+static uint8_t expected[LCD_SIZE];
+
+/**
+ * @brief Deterministic pseudo random numbers, same sequence on every host.
+ */
+static uint32_t randomNext()
+{
+  static uint32_t state = 12345;
+
+  state = state * 1103515245 + 12345;
+
+  return state >> 8;
+}
+
+/**
+ * @brief Floor of a / b, b > 0.
+ */
+static int64_t floorDiv(int64_t a, int64_t b)
+{
+  return a / b - (a % b < 0);
+}
+
+/**
+ * @brief Reference fill: y of every crossing at the column center in Q8, rounded down, xor into expected.
+ */
+static void referenceFill(const struct LCD_point *p, uint8_t count)
+{
+  for (int16_t x = 0; x < LCD_WIDTH; x++)
+  {
+    int32_t crossings[LCD_POLYGON_MAX_POINTS];
+    uint8_t n = 0;
+
+    for (uint8_t i = 0, j = count - 1; i < count; j = i++)
+    {
+      if ((p[i].x <= x) == (p[j].x <= x))
+        continue;
+
+      int64_t num = (int64_t)(2 * (x - p[i].x) + 1) * (p[j].y - p[i].y) * 256;
+      int64_t den = 2 * (p[j].x - p[i].x);
+      int32_t y = p[i].y * 256 + (den < 0 ? floorDiv(-num, -den) : floorDiv(num, den));
+      uint8_t k = n++;
+
+      for (; k > 0 && crossings[k - 1] > y; k--)
+        crossings[k] = crossings[k - 1];
+      crossings[k] = y;
+    }
+
+    for (uint8_t i = 0; i + 1 < n; i += 2)
+    {
+      // Pixel centers within the span, ceil(y - 0.5)
+      int64_t top = -floorDiv(128 - crossings[i], 256);
+      int64_t bottom = -floorDiv(128 - crossings[i + 1], 256) - 1;
+
+      for (int64_t y = top < 0 ? 0 : top; y <= bottom && y < LCD_HEIGHT; y++)
+        expected[(y / LCD_COLUMN_HEIGHT) * LCD_WIDTH + x] ^= 1 << (y % LCD_COLUMN_HEIGHT);
+    }
+  }
+}
+
+static void testTransformPoint()
+{
+  struct LCD_point p;
+
+  // Products of these points pass 32 bits before the translation brings them back
+  LCD_transformIdentity();
+  LCD_transformTranslate(-30000, 0);
+  LCD_transformScale(2 * LCD_Q16_ONE, LCD_Q16_ONE);
+  p = LCD_transformPoint((struct LCD_point){20000, 5});
+  CHECK(p.x == 10000 && p.y == 5);
+
+  LCD_transformIdentity();
+  LCD_transformTranslate(0, -20000);
+  LCD_transformRotate(LCD_ANGLE_FULL / 8);
+  p = LCD_transformPoint((struct LCD_point){30000, 30000});
+  CHECK(p.x >= -1 && p.x <= 1);
+  CHECK(p.y >= 22425 && p.y <= 22427);
+
+  LCD_transformIdentity();
+  p = LCD_transformPoint((struct LCD_point){-32768, 32767});
+  CHECK(p.x == -32768 && p.y == 32767);
+}
+
+static void testClip()
+{
+  uint8_t clipped[LCD_SIZE];
+
+  // Far ends, deltas multiply past 32 bits while clipping
+  LCD_transformIdentity();
+  LCD_clrBuff();
+  LCD_vectorLine((struct LCD_point){-30000, -30000}, (struct LCD_point){30000, 30000}, LCD_DRAW_SET);
+  memcpy(clipped, lcd.buffer, LCD_SIZE);
+
+  LCD_clrBuff();
+  LCD_drawLineOp(0, 0, LCD_HEIGHT - 1, LCD_HEIGHT - 1, LCD_DRAW_SET);
+  CHECK(!memcmp(clipped, lcd.buffer, LCD_SIZE));
+}
+
+static void testFillPolygon()
+{
+  struct LCD_point rectangle[4] = {{2, 3}, {12, 3}, {12, 8}, {2, 8}};
+  uint16_t area = 0;
+  uint16_t mismatches = 0;
+
+  LCD_transformIdentity();
+  LCD_clrBuff();
+  LCD_vectorFillPolygon(rectangle, 4, LCD_DRAW_SET);
+  for (uint16_t i = 0; i < LCD_SIZE; i++)
+    area += __builtin_popcount(lcd.buffer[i]);
+  CHECK(area == 50);
+  CHECK(LCD_getPixel(2, 3) && LCD_getPixel(11, 7) && !LCD_getPixel(12, 8));
+
+  for (uint16_t polygon = 0; polygon < POLYGONS; polygon++)
+  {
+    struct LCD_point p[LCD_POLYGON_MAX_POINTS];
+    uint8_t count = 3 + randomNext() % (LCD_POLYGON_MAX_POINTS - 2);
+    int16_t range = polygon % 2 ? 120 : 400;
+
+    for (uint8_t i = 0; i < count; i++)
+    {
+      p[i].x = randomNext() % range - range / 4;
+      p[i].y = randomNext() % range - range / 4;
+    }
+
+    memset(expected, 0, LCD_SIZE);
+    referenceFill(p, count);
+    LCD_clrBuff();
+    LCD_vectorFillPolygon(p, count, LCD_DRAW_XOR);
+    mismatches += memcmp(expected, lcd.buffer, LCD_SIZE) != 0;
+
+    // Same polygon in xor mode again restores the frame
+    LCD_vectorFillPolygon(p, count, LCD_DRAW_XOR);
+    memset(expected, 0, LCD_SIZE);
+    mismatches += memcmp(expected, lcd.buffer, LCD_SIZE) != 0;
+  }
+
+  CHECK(mismatches == 0);
+}
+
+int main()
+{
+  testTransformPoint();
+  testClip();
+  testFillPolygon();
+
+  if (failures)
+    printf("%d check(s) failed\n", failures);
+  else
+    printf("all checks passed\n");
+
+  return failures != 0;
+}
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+#
+# File: capture_compare.py
+# Project: dwm_pico_5110_lcd
+# -----
+# This source code is released under GPLv3 license.
+# Check LICENSE file for license agreement,
+# copyrights, 3rd party licenses and changes info can be found in COPYING file.
+# -----
+# Copyright 2023 - 2023 M.Kusiak (timax)
+#
+# Compares frames captured with LCD_captureStream() against golden images.
+#
+# Capture is a raw dump of the board's stdio (e.g. `cat /dev/ttyACM0 > run.bin`),
+# frames in PBM and binary format may be mixed with regular text output.
+# Every frame is compared with <golden>/frame_NNN.pbm, pixel diffs and rendering
+# cost (with the cost stored in the golden image) are reported in one table.
+#
+# usage: capture_compare.py run.bin golden/ [--update] [--diff-dir DIR] [--max-cost-increase PCT]
+
+import argparse
+import os
+import re
+import sys
+
+MAGIC = b"LCDF"
+HEADER_SIZE = 12
+PBM_HEADER = re.compile(rb"P4\n(?:# cost_us (\d+)\n)?(\d+) (\d+)\n")
+FLAG_INVERTED = 0x02
+
+
+class Frame:
+    def __init__(self, width, height, pixels, cost):
+        self.width = width
+        self.height = height
+        self.pixels = pixels  # list of rows, 1 = dark pixel
+        self.cost = cost
+
+
+def parse_pbm(data, pos):
+    match = PBM_HEADER.match(data, pos)
+    if not match:
+        return None, pos + 1
+
+    width, height = int(match.group(2)), int(match.group(3))
+    stride = (width + 7) // 8
+    start = match.end()
+    if start + stride * height > len(data):
+        return None, len(data)
+
+    pixels = [[(data[start + y * stride + x // 8] >> (7 - x % 8)) & 1 for x in range(width)] for y in range(height)]
+    cost = int(match.group(1)) if match.group(1) else None
+
+    return Frame(width, height, pixels, cost), start + stride * height
+
+
+def parse_binary(data, pos):
+    if pos + HEADER_SIZE > len(data):
+        return None, len(data)
+
+    width, height, flags = data[pos + 4], data[pos + 5], data[pos + 6]
+    cost = int.from_bytes(data[pos + 8:pos + 12], "little")
+    start = pos + HEADER_SIZE
+    if start + width * height // 8 > len(data):
+        return None, len(data)
+
+    # LCD's layout: bytes are 8 pixel high columns, least significant bit on top
+    invert = 1 if flags & FLAG_INVERTED else 0
+    pixels = [[((data[start + (y // 8) * width + x] >> (y % 8)) & 1) ^ invert for x in range(width)] for y in range(height)]
+
+    return Frame(width, height, pixels, cost), start + width * height // 8
+
+
+def parse_capture(data):
+    frames = []
+    pos = 0
+
+    while pos < len(data):
+        pbm = data.find(b"P4\n", pos)
+        binary = data.find(MAGIC, pos)
+        candidates = [p for p in (pbm, binary) if p >= 0]
+        if not candidates:
+            break
+
+        pos = min(candidates)
+        frame, pos = parse_binary(data, pos) if pos == binary else parse_pbm(data, pos)
+        if frame:
+            frames.append(frame)
+
+    return frames
+
+
+def write_pbm(path, frame, pixels=None):
+    pixels = pixels or frame.pixels
+    stride = (frame.width + 7) // 8
+
+    with open(path, "wb") as f:
+        f.write(b"P4\n")
+        if frame.cost is not None:
+            f.write(b"# cost_us %d\n" % frame.cost)
+        f.write(b"%d %d\n" % (frame.width, frame.height))
+        for row in pixels:
+            line = bytearray(stride)
+            for x, pixel in enumerate(row):
+                line[x // 8] |= pixel << (7 - x % 8)
+            f.write(line)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare captured LCD frames against golden images.")
+    parser.add_argument("capture", help="raw stdio dump containing captured frames")
+    parser.add_argument("golden", help="directory with golden frame_NNN.pbm images")
+    parser.add_argument("--update", action="store_true", help="store captured frames as new golden images")
+    parser.add_argument("--diff-dir", help="write XOR images of differing frames here")
+    parser.add_argument("--max-cost-increase", type=float, default=None,
+                        help="fail if rendering cost grows by more than PCT percent")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        frames = parse_capture(f.read())
+
+    if not frames:
+        print("no frames found in %s" % args.capture)
+        return 1
+
+    if args.update:
+        os.makedirs(args.golden, exist_ok=True)
+        for i, frame in enumerate(frames):
+            write_pbm(os.path.join(args.golden, "frame_%03d.pbm" % i), frame)
+        print("stored %d golden frames in %s" % (len(frames), args.golden))
+        return 0
+
+    if args.diff_dir:
+        os.makedirs(args.diff_dir, exist_ok=True)
+
+    failed = 0
+    print("%-6s %8s %10s %10s %8s" % ("frame", "diff_px", "cost_us", "golden_us", "delta"))
+
+    for i, frame in enumerate(frames):
+        path = os.path.join(args.golden, "frame_%03d.pbm" % i)
+        if not os.path.exists(path):
+            print("%-6d missing golden image %s" % (i, path))
+            failed += 1
+            continue
+
+        with open(path, "rb") as f:
+            golden, _ = parse_pbm(f.read(), 0)
+
+        if not golden or (golden.width, golden.height) != (frame.width, frame.height):
+            print("%-6d size differs from %s" % (i, path))
+            failed += 1
+            continue
+
+        diff = [[a ^ b for a, b in zip(row, golden_row)] for row, golden_row in zip(frame.pixels, golden.pixels)]
+        diff_pixels = sum(map(sum, diff))
+
+        delta = ""
+        slower = False
+        if frame.cost is not None and golden.cost:
+            increase = 100.0 * (frame.cost - golden.cost) / golden.cost
+            delta = "%+.1f%%" % increase
+            slower = args.max_cost_increase is not None and increase > args.max_cost_increase
+
+        print("%-6d %8d %10s %10s %8s%s" % (i, diff_pixels,
+                                            "-" if frame.cost is None else frame.cost,
+                                            "-" if golden.cost is None else golden.cost,
+                                            delta, "  SLOWER" if slower else ""))
+
+        if diff_pixels and args.diff_dir:
+            write_pbm(os.path.join(args.diff_dir, "diff_%03d.pbm" % i), frame, diff)
+
+        if diff_pixels or slower:
+            failed += 1
+
+    print("%d of %d frames failed" % (failed, len(frames)))
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())